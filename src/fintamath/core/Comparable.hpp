@@ -58,25 +58,24 @@ namespace fintamath {
     ~ComparableImpl() override = default;
 
     bool operator<(const Derived &rhs) const {
-      return less(rhs);
+      return compare(rhs) < 0;
     }
 
     bool operator>(const Derived &rhs) const {
-      return more(rhs);
+      return compare(rhs) > 0;
     }
 
     bool operator<=(const Derived &rhs) const {
-      return !more(rhs);
+      return compare(rhs) <= 0;
     }
 
     bool operator>=(const Derived &rhs) const {
-      return !less(rhs);
+      return compare(rhs) >= 0;
     }
 
   protected:
-    virtual bool less(const Derived &rhs) const = 0;
-
-    virtual bool more(const Derived &rhs) const = 0;
+    // Three-way comparison: -1, 0 or 1 if this is less than, equal to or greater than rhs
+    virtual int compare(const Derived &rhs) const = 0;
 
     bool lessAbstract(const Comparable &rhs) const final {
       FINTAMATH_CALL_OPERATOR(<);
@@ -0,0 +1,150 @@
+#include "fintamath/core/ThreadPool.hpp"
+
+namespace fintamath {
+  // Pool and queue of the current worker thread
+  thread_local const ThreadPool *currentPool = nullptr;
+  thread_local size_t currentQueueIndex = 0;
+
+  // The calling thread takes part in the runs, so the pool starts one worker less than threadsNum
+  ThreadPool::ThreadPool(size_t threadsNum) {
+    size_t workersNum = threadsNum > 1 ? threadsNum - 1 : 0;
+
+    for (size_t i = 0; i < workersNum + 1; i++) {
+      queues.emplace_back(std::make_unique<TaskQueue>());
+    }
+    for (size_t i = 0; i < workersNum; i++) {
+      workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+  }
+
+  ThreadPool::~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(waitMutex);
+      isStopped = true;
+    }
+    waitCondition.notify_all();
+
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+
+  size_t ThreadPool::getThreadsNum() const {
+    return workers.size() + 1;
+  }
+
+  /*
+    Running the tasks and waiting for them to finish. The first task is executed by the calling thread at once, the
+    others are queued for the workers. While waiting the thread executes any tasks it can find, first its own ones.
+    When there are none, it sleeps until new tasks are queued or its last task is finished.
+    The first exception thrown by the tasks is rethrown after all of them are finished.
+  */
+  void ThreadPool::run(const std::vector<std::function<void()>> &tasks) {
+    if (tasks.empty()) {
+      return;
+    }
+
+    TaskGroup group;
+    group.remainingNum = tasks.size();
+    size_t index = getQueueIndex();
+
+    if (tasks.size() > 1) {
+      // The counter is increased first, so it never drops below zero when the tasks are taken at once
+      {
+        std::lock_guard<std::mutex> lock(waitMutex);
+        queuedNum += tasks.size() - 1;
+      }
+      {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        for (size_t i = 1; i < tasks.size(); i++) {
+          queues[index]->tasks.push_back(Task{&tasks[i], &group});
+        }
+      }
+      waitCondition.notify_all();
+    }
+
+    execute(Task{&tasks.front(), &group});
+
+    while (group.remainingNum.load(std::memory_order_acquire) != 0) {
+      Task task;
+      if (popTask(index, task)) {
+        execute(task);
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(waitMutex);
+      waitCondition.wait(lock, [this, &group] {
+        return group.remainingNum.load(std::memory_order_acquire) == 0 || queuedNum != 0;
+      });
+    }
+
+    if (group.error) {
+      std::rethrow_exception(group.error);
+    }
+  }
+
+  void ThreadPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentQueueIndex = index;
+
+    while (true) {
+      Task task;
+      if (popTask(index, task)) {
+        execute(task);
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(waitMutex);
+      waitCondition.wait(lock, [this] { return isStopped || queuedNum != 0; });
+      if (isStopped) {
+        return;
+      }
+    }
+  }
+
+  size_t ThreadPool::getQueueIndex() const {
+    return currentPool == this ? currentQueueIndex : queues.size() - 1;
+  }
+
+  // Taking the newest task of the own queue, otherwise stealing the oldest task of another queue
+  bool ThreadPool::popTask(size_t index, Task &task) {
+    for (size_t i = 0; i < queues.size(); i++) {
+      TaskQueue &queue = *queues[(index + i) % queues.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+
+      if (queue.tasks.empty()) {
+        continue;
+      }
+
+      if (i == 0) {
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+      } else {
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+      }
+      queuedNum--;
+      return true;
+    }
+
+    return false;
+  }
+
+  // Executing the task and waking the thread waiting for its group if it is the last one
+  void ThreadPool::execute(const Task &task) {
+    try {
+      (*task.func)();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(task.group->errorMutex);
+      if (!task.group->error) {
+        task.group->error = std::current_exception();
+      }
+    }
+
+    if (task.group->remainingNum.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      // The group may be destroyed from here on. Under the mutex the waiting thread either sees the counter or sleeps
+      std::lock_guard<std::mutex> lock(waitMutex);
+      waitCondition.notify_all();
+    }
+  }
+}
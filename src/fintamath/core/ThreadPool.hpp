@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fintamath {
+  /*
+    Pool of threads for fork-join parallelism with work stealing. Every worker has its own queue: tasks are pushed to
+    the queue of the thread that runs them and taken from its back, idle workers steal tasks from the fronts of the
+    other queues. A thread waiting for its tasks executes queued tasks meanwhile, so nested runs never block the pool.
+  */
+  class ThreadPool {
+  public:
+    explicit ThreadPool(size_t threadsNum);
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool();
+
+    size_t getThreadsNum() const;
+
+    void run(const std::vector<std::function<void()>> &tasks);
+
+  private:
+    struct TaskGroup {
+      std::atomic<size_t> remainingNum{0};
+      std::mutex errorMutex;
+      std::exception_ptr error;
+    };
+
+    struct Task {
+      const std::function<void()> *func = nullptr;
+      TaskGroup *group = nullptr;
+    };
+
+    struct TaskQueue {
+      std::mutex mutex;
+      std::deque<Task> tasks;
+    };
+
+    void workerLoop(size_t index);
+
+    size_t getQueueIndex() const;
+
+    bool popTask(size_t index, Task &task);
+
+    void execute(const Task &task);
+
+    // Queues of the workers and the last one shared by the threads outside the pool
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex waitMutex;
+    std::condition_variable waitCondition;
+    std::atomic<size_t> queuedNum{0};
+    bool isStopped = false;
+  };
+}
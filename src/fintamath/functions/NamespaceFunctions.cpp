@@ -15,7 +15,6 @@ namespace fintamath {
   const int64_t PI_INITIAL_PRECISION = 72;
 
   int64_t getNewPrecision(int64_t precision);
-  Rational getInversedPrecisionVal(int64_t precision);
 
   Rational lnReduce(const Rational &rhs, Integer &multiplier, int64_t precision);
   Rational naturalPow(const Rational &lhs, const Integer &rhs);
@@ -38,13 +37,9 @@ namespace fintamath {
         return Integer(0);
       }
 
-      std::string shift(size_t(precision), '0');
-      std::string shiftMult2(size_t(precision) * 2, '0');
-      shift.insert(shift.begin(), '1');
-      shiftMult2.insert(shiftMult2.begin(), '1');
-
-      Rational val((rhs * Integer(shiftMult2)).getInteger().sqrt(), Integer(shift));
-      return val.round(precision);
+      Rational scaledRhs = rhs;
+      Rational val = scaledRhs.scaleByPow10(precision * 2).getInteger().sqrt();
+      return val.scaleByPow10(-precision).round(precision);
     }
 
     // Using formula: log(a, b) = ln(b) / ln(a).
@@ -69,7 +64,7 @@ namespace fintamath {
       Integer step = 1;
       Rational precisionVal = getInversedPrecisionVal(getNewPrecision(precision));
       Rational powRhs = rhsStep;
-      Rational rhsSqr = (rhsStep * rhsStep).round(getNewPrecision(precision));
+      Rational rhsSqr = rhsStep.square().round(getNewPrecision(precision));
       Rational res = rhsStep;
 
       do {
@@ -112,7 +107,9 @@ namespace fintamath {
       if (lhs == 0 && rhs == 0) {
         throw std::domain_error("Zero pow zero");
       }
-      if (lhs < 0 && rhs.getNumerator() != 0) {
+      Integer rhsFraction;
+      Integer rhsInteger = rhs.splitIntegerFraction(rhsFraction);
+      if (lhs < 0 && rhsFraction != 0) {
         throw std::domain_error("pow out of range");
       }
       if (rhs == 0) {
@@ -124,12 +121,12 @@ namespace fintamath {
         rhsStep = 1 / rhsStep;
       }
 
-      Rational lhsPowIntRhs = naturalPow(rhsStep, rhs.getInteger());
+      Rational lhsPowIntRhs = naturalPow(rhsStep, rhsInteger);
       if (rhs.getDenominator() == 1) {
         return lhsPowIntRhs;
       }
 
-      auto rhsMultLnRhs = Rational(rhs.getNumerator(), rhs.getDenominator()) * ln(rhsStep, precision);
+      auto rhsMultLnRhs = Rational(rhsFraction, rhs.getDenominator()) * ln(rhsStep, precision);
 
       Integer step = 1;
       Rational precisionVal = getInversedPrecisionVal(getNewPrecision(precision));
@@ -181,7 +178,7 @@ namespace fintamath {
 
       Integer step = 2;
       Rational precisionVal = getInversedPrecisionVal(getNewPrecision(precision));
-      Rational rhsSqr = (rhsStep * rhsStep).round(getNewPrecision(precision));
+      Rational rhsSqr = rhsStep.square().round(getNewPrecision(precision));
       Rational res = rhsStep;
 
       do {
@@ -226,7 +223,7 @@ namespace fintamath {
 
       Integer step = 2;
       Rational precisionVal = getInversedPrecisionVal(getNewPrecision(precision));
-      Rational rhsSqr = (rhsStep * rhsStep).round(getNewPrecision(precision));
+      Rational rhsSqr = rhsStep.square().round(getNewPrecision(precision));
       Rational res = Integer(1);
       rhsStep = 1;
 
@@ -275,7 +272,7 @@ namespace fintamath {
 
       val = cos(val, precision);
 
-      Rational res = sqrt(1 - val * val, precision) / val;
+      Rational res = sqrt(1 - val.square(), precision) / val;
       if (isNegative) {
         res = -res;
       }
@@ -315,7 +312,7 @@ namespace fintamath {
         throw std::domain_error("cot out of range");
       }
 
-      Rational res = sqrt(1 - sinVal * sinVal, precision) / sinVal;
+      Rational res = sqrt(1 - sinVal.square(), precision) / sinVal;
       if (isNegative) {
         res = -res;
       }
@@ -353,7 +350,7 @@ namespace fintamath {
         Integer step = 1;
         Rational precisionVal = getInversedPrecisionVal(getNewPrecision(precision));
         Rational val = rhsStep;
-        Rational rhsSqr = (rhsStep * rhsStep).round(getNewPrecision(precision));
+        Rational rhsSqr = rhsStep.square().round(getNewPrecision(precision));
         Rational res = rhsStep;
 
         do {
@@ -396,7 +393,7 @@ namespace fintamath {
         Integer step = 2;
         Rational precisionVal = getInversedPrecisionVal(getNewPrecision(precision));
         Rational val = rhsStep;
-        Rational rhsSqr = (rhsStep * rhsStep).round(getNewPrecision(precision));
+        Rational rhsSqr = rhsStep.square().round(getNewPrecision(precision));
         Rational res = rhsStep;
 
         do {
@@ -414,7 +411,7 @@ namespace fintamath {
         return res.round(precision);
       }
 
-      Rational res = acos(1 / sqrt(1 + rhsStep * rhsStep, precision), precision);
+      Rational res = acos(1 / sqrt(1 + rhsStep.square(), precision), precision);
       if (isNegative) {
         res = -res;
       }
@@ -431,21 +428,25 @@ namespace fintamath {
     }
 
     Rational factorial(const Rational &rhs) {
-      if (rhs < 0 || rhs.getNumerator() != 0) {
+      Integer rhsFraction;
+      Integer rhsInteger = rhs.splitIntegerFraction(rhsFraction);
+      if (rhs < 0 || rhsFraction != 0) {
         throw std::domain_error("factorial out of range");
       }
       if (rhs < 2) {
         return Integer(1);
       }
-      return factorialRec(2, rhs.getInteger());
+      return factorialRec(2, rhsInteger);
     }
 
     Rational doubleFactorial(const Rational &rhs) {
-      if (rhs < 0 || rhs.getNumerator() != 0) {
+      Integer rhsFraction;
+      Integer rhsInteger = rhs.splitIntegerFraction(rhsFraction);
+      if (rhs < 0 || rhsFraction != 0) {
         throw std::domain_error("factorial out of range");
       }
       Integer res = 1;
-      for (Integer i = rhs.getInteger(); i > 0; i -= 2) {
+      for (Integer i = rhsInteger; i > 0; i -= 2) {
         res *= i;
       }
       return res;
@@ -504,7 +505,7 @@ namespace fintamath {
         a = (prevA + prevB) / 2;
         b = sqrt(prevA * prevB, precision);
         Rational diff = (prevA - a);
-        t = (prevT - p * diff * diff).round(precision);
+        t = (prevT - p * diff.square()).round(precision);
         p *= 2;
       }
 
@@ -517,9 +518,8 @@ namespace fintamath {
   }
 
   Rational getInversedPrecisionVal(int64_t precision) {
-    std::string precStr(size_t(precision) + 1, '0');
-    precStr.front() = '1';
-    return (Rational(1, Integer(precStr)));
+    Rational res = 1;
+    return res.scaleByPow10(-precision);
   }
 
   /*
@@ -552,7 +552,7 @@ namespace fintamath {
     while (tmpRhs != 0) {
       if ((*(tmpRhs.toString().end() - 1) - '0') % 2 == 0) {
         tmpRhs /= 2;
-        tmpLhs *= tmpLhs;
+        tmpLhs = tmpLhs.square();
       } else {
         --tmpRhs;
         res *= tmpLhs;
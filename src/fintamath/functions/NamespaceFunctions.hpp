@@ -2,6 +2,11 @@
 
 #include "fintamath/numbers/Rational.hpp"
 
+namespace fintamath {
+  // 10^(-precision), the series are summed until their terms are not greater than it
+  Rational getInversedPrecisionVal(int64_t precision);
+}
+
 namespace fintamath::functions {
   Rational getE(int64_t precision);
 
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+
+namespace fintamath {
+  /*
+    Vector of Integer limbs. Values of up to INLINE_CAPACITY limbs are stored inside the object, larger ones are moved
+    to the heap transparently on growth.
+  */
+  class IntVector {
+  public:
+    using value_type = uint64_t;
+    using iterator = uint64_t *;
+    using const_iterator = const uint64_t *;
+
+    static constexpr size_t INLINE_CAPACITY = 2;
+
+    IntVector() = default;
+
+    IntVector(size_t count, uint64_t val) {
+      assign(count, val);
+    }
+
+    IntVector(std::initializer_list<uint64_t> list) {
+      assign(list.begin(), list.end());
+    }
+
+    IntVector(const_iterator first, const_iterator last) {
+      assign(first, last);
+    }
+
+    IntVector(const IntVector &rhs) {
+      assign(rhs.begin(), rhs.end());
+    }
+
+    IntVector(IntVector &&rhs) noexcept {
+      moveFrom(rhs);
+    }
+
+    ~IntVector() {
+      release();
+    }
+
+    IntVector &operator=(const IntVector &rhs) {
+      if (this != &rhs) {
+        assign(rhs.begin(), rhs.end());
+      }
+      return *this;
+    }
+
+    IntVector &operator=(IntVector &&rhs) noexcept {
+      if (this != &rhs) {
+        release();
+        moveFrom(rhs);
+      }
+      return *this;
+    }
+
+    size_t size() const {
+      return length;
+    }
+
+    bool empty() const {
+      return length == 0;
+    }
+
+    size_t capacity() const {
+      return cap;
+    }
+
+    bool isInline() const {
+      return cap == INLINE_CAPACITY;
+    }
+
+    uint64_t *data() {
+      return isInline() ? storage.inlineData : storage.heapData;
+    }
+
+    const uint64_t *data() const {
+      return isInline() ? storage.inlineData : storage.heapData;
+    }
+
+    iterator begin() {
+      return data();
+    }
+
+    iterator end() {
+      return data() + length;
+    }
+
+    const_iterator begin() const {
+      return data();
+    }
+
+    const_iterator end() const {
+      return data() + length;
+    }
+
+    uint64_t &operator[](size_t pos) {
+      return data()[pos];
+    }
+
+    const uint64_t &operator[](size_t pos) const {
+      return data()[pos];
+    }
+
+    uint64_t &front() {
+      return data()[0];
+    }
+
+    const uint64_t &front() const {
+      return data()[0];
+    }
+
+    uint64_t &back() {
+      return data()[length - 1];
+    }
+
+    const uint64_t &back() const {
+      return data()[length - 1];
+    }
+
+    void reserve(size_t newCap) {
+      if (newCap <= cap) {
+        return;
+      }
+
+      auto *newData = new uint64_t[newCap];
+      std::copy(begin(), end(), newData);
+      release();
+      storage.heapData = newData;
+      cap = newCap;
+    }
+
+    void resize(size_t newSize, uint64_t val = 0) {
+      if (newSize > cap) {
+        reserve(std::max(newSize, cap * 2));
+      }
+      if (newSize > length) {
+        std::fill(end(), begin() + newSize, val);
+      }
+      length = newSize;
+    }
+
+    void clear() {
+      length = 0;
+    }
+
+    void push_back(uint64_t val) { // NOLINT
+      if (length == cap) {
+        reserve(cap * 2);
+      }
+      data()[length++] = val;
+    }
+
+    void pop_back() { // NOLINT
+      length--;
+    }
+
+    iterator insert(const_iterator pos, size_t count, uint64_t val) {
+      size_t offset = size_t(pos - begin());
+      size_t oldSize = length;
+      resize(length + count);
+      std::copy_backward(begin() + offset, begin() + oldSize, end());
+      std::fill(begin() + offset, begin() + offset + count, val);
+      return begin() + offset;
+    }
+
+    iterator insert(const_iterator pos, const_iterator first, const_iterator last) {
+      size_t offset = size_t(pos - begin());
+      auto count = size_t(last - first);
+      size_t oldSize = length;
+      resize(length + count);
+      std::copy_backward(begin() + offset, begin() + oldSize, end());
+      std::copy(first, last, begin() + offset);
+      return begin() + offset;
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+      size_t offset = size_t(first - begin());
+      auto count = size_t(last - first);
+      std::copy(begin() + offset + count, end(), begin() + offset);
+      length -= count;
+      return begin() + offset;
+    }
+
+  private:
+    void assign(size_t count, uint64_t val) {
+      length = 0;
+      resize(count, val);
+    }
+
+    void assign(const_iterator first, const_iterator last) {
+      auto count = size_t(last - first);
+      if (count > cap) {
+        release();
+        storage.heapData = new uint64_t[count];
+        cap = count;
+      }
+      std::copy(first, last, begin());
+      length = count;
+    }
+
+    void moveFrom(IntVector &rhs) {
+      length = rhs.length;
+      cap = rhs.cap;
+      if (rhs.isInline()) {
+        std::copy(rhs.storage.inlineData, rhs.storage.inlineData + length, storage.inlineData);
+      } else {
+        storage.heapData = rhs.storage.heapData;
+      }
+      rhs.length = 0;
+      rhs.cap = INLINE_CAPACITY;
+    }
+
+    void release() {
+      if (!isInline()) {
+        delete[] storage.heapData;
+        cap = INLINE_CAPACITY;
+      }
+    }
+
+    size_t length = 0;
+    size_t cap = INLINE_CAPACITY;
+
+    union {
+      uint64_t inlineData[INLINE_CAPACITY]; // NOLINT
+      uint64_t *heapData;
+    } storage{};
+  };
+}
@@ -1,69 +1,379 @@
 #include "fintamath/numbers/Integer.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <memory>
 #include <stdexcept>
+#include <vector>
 
-namespace fintamath {
-  using IntVector = std::vector<int64_t>;
-
-  constexpr int8_t INT_BASE_SIZE = 9;
-  constexpr int64_t INT_BASE = 1000000000;
-  constexpr int64_t KARATSUBA_CUTOFF = 64;
+#include "fintamath/core/ThreadPool.hpp"
+#include "fintamath/numbers/LimbsKernels.hpp"
 
-  IntVector toIntVector(const std::string_view &str, int64_t baseSize);
+namespace fintamath {
+  // Product of two limbs, used for carries in multiplication and division
+  __extension__ typedef unsigned __int128 uint128_t;
+  __extension__ typedef __int128 int128_t;
+
+  constexpr uint64_t INT_BASE_SIZE = 64;
+  constexpr size_t DECIMAL_BASE_SIZE = 19;
+  constexpr uint64_t DECIMAL_BASE = 10000000000000000000U;
+  constexpr size_t KARATSUBA_CUTOFF = 32;
+  constexpr size_t TOOM_3_CUTOFF = 256;
+  constexpr size_t TOOM_4_CUTOFF = 1536;
+  constexpr size_t NTT_CUTOFF = 2048;
+  constexpr size_t NTT_PRIMES_NUM = 3;
+  constexpr size_t NTT_BLOCK_CUTOFF = 4096;
+  constexpr size_t BURNIKEL_ZIEGLER_CUTOFF = 128;
+  constexpr size_t EXACT_DIVIDE_CUTOFF = 512;
+  constexpr size_t LEHMER_BITS_NUM = 62;
+  constexpr size_t HALF_GCD_CUTOFF = 256;
+  constexpr size_t MONTGOMERY_CUTOFF = 32;
+  constexpr double LOG_ESTIMATE_PRECISION = 1e-6;
+  constexpr uint64_t LOG2_10_HIGH = 0xd49a784bcd1b8afe;
+  constexpr uint64_t LOG2_10_LOW = 0x492bf6ff4dafdb4c;
+  constexpr size_t PARSE_CUTOFF = 1024;
+  constexpr size_t TO_STRING_CUTOFF = 32;
+  constexpr size_t PARALLEL_MULTIPLY_CUTOFF = 1024;
+
+  // Number with a sign, used in intermediate calculations where the values can be negative
+  struct SignedIntVector {
+    IntVector intVect{0};
+    bool sign{};
+  };
+
+  // Matrix of Euclid's steps. The numbers are reduced as (A', B') = M (A, B), the determinant is 1 or -1
+  struct GcdMatrix {
+    std::array<SignedIntVector, 4> vals{SignedIntVector{IntVector{1}, false}, SignedIntVector{}, SignedIntVector{},
+                                        SignedIntVector{IntVector{1}, false}};
+  };
+
+  // Prime modulus of the number-theoretic transform. All the values modulo it are stored in Montgomery's form
+  struct NttPrime {
+    uint64_t mod;
+    uint64_t modInv;
+    uint64_t r2;
+    uint64_t root;
+    uint64_t rootInv;
+  };
+
+  // Transforms of the last multiplier, reused when the same number is multiplied repeatedly
+  struct NttCache {
+    IntVector intVect;
+    size_t size = 0;
+    std::array<std::vector<uint64_t>, NTT_PRIMES_NUM> transforms;
+  };
+
+  const IntVector &getDecimalBasePow(size_t level);
+  const IntVector &decimalPow(size_t exp);
+  size_t decimalPowBitsNum(size_t exp);
+  IntVector toIntVector(const std::string_view &str);
   bool canConvert(const std::string_view &str);
-  std::string toString(const IntVector &intVect, int64_t baseSize);
+  std::string toString(const IntVector &intVect);
 
-  int64_t firstZeroNum(const IntVector &rhs);
+  size_t firstZeroNum(const IntVector &rhs);
+  int compareShifted(const IntVector &lhs, size_t lhsShift, const IntVector &rhs, size_t rhsShift);
 
   void toSignificantDigits(IntVector &rhs);
-  void toBasePositive(IntVector &rhs, size_t pos, int64_t base);
-  void toBaseNegative(IntVector &rhs, size_t pos, int64_t base);
+  IntVector shiftLeft(const IntVector &lhs, uint64_t bitsNum);
+  IntVector shiftRight(const IntVector &lhs, uint64_t bitsNum);
 
   bool equal(const IntVector &lhs, const IntVector &rhs);
   bool less(const IntVector &lhs, const IntVector &rhs);
   bool greater(const IntVector &lhs, const IntVector &rhs);
 
-  IntVector add(const IntVector &lhs, const IntVector &rhs, int64_t base);
-  IntVector addToSignificantDigits(const IntVector &lhs, const IntVector &rhs, int64_t base);
-
-  IntVector substract(const IntVector &lhs, const IntVector &rhs, int64_t base);
-
-  IntVector shortMultiply(const IntVector &lhs, int64_t rhs, int64_t base);
-  IntVector polynomialMultiply(const IntVector &lhs, const IntVector &rhs, int64_t base);
-  IntVector karatsubaMultiply(const IntVector &lhs, const IntVector &rhs, int64_t base);
-  int64_t zerosMultiply(IntVector &lhs, IntVector &rhs);
-  IntVector multiply(const IntVector &lhs, const IntVector &rhs, int64_t base);
-
-  IntVector shortDivide(const IntVector &lhs, int64_t rhs, int64_t base);
-  IntVector shortDivide(const IntVector &lhs, int64_t rhs, IntVector &modVal, int64_t base);
-  void zerosDivide(IntVector &lhs, IntVector &rhs);
-  IntVector binsearchDivide(const IntVector &lhs, const IntVector &rhs, IntVector &left, IntVector &right,
-                            int64_t base);
-  IntVector divide(const IntVector &lhs, const IntVector &rhs, IntVector &modVal, int64_t base);
-
+  IntVector add(const IntVector &lhs, const IntVector &rhs);
+  IntVector addToSignificantDigits(const IntVector &lhs, const IntVector &rhs);
+  void addShifted(IntVector &lhs, const IntVector &rhs, size_t offset);
+
+  IntVector substract(const IntVector &lhs, const IntVector &rhs);
+
+  IntVector shortMultiply(const IntVector &lhs, uint64_t rhs);
+  void polynomialMultiply(const uint64_t *lhs, size_t lhsSize, const uint64_t *rhs, size_t rhsSize, uint64_t *res);
+  IntVector polynomialMultiply(const IntVector &lhs, const IntVector &rhs);
+  uint64_t addLimbs(uint64_t *lhs, size_t lhsSize, const uint64_t *rhs, size_t rhsSize);
+  uint64_t substractLimbs(uint64_t *lhs, size_t lhsSize, const uint64_t *rhs, size_t rhsSize);
+  bool absDiffLimbs(const uint64_t *lhs, size_t lhsSize, const uint64_t *rhs, size_t rhsSize, uint64_t *res);
+  size_t karatsubaScratchSize(size_t size);
+  void karatsubaMultiply(const uint64_t *lhs, const uint64_t *rhs, size_t size, uint64_t *res, uint64_t *scratch);
+  IntVector karatsubaMultiply(const IntVector &lhs, const IntVector &rhs);
+  void polynomialSquare(const uint64_t *rhs, size_t size, uint64_t *res);
+  void karatsubaSquare(const uint64_t *rhs, size_t size, uint64_t *res, uint64_t *scratch);
+  std::vector<IntVector> splitToParts(const IntVector &rhs, size_t partSize, size_t partsNum);
+  SignedIntVector evaluatePolynomial(const std::vector<IntVector> &coeffs, int64_t point);
+  IntVector toomCookMultiply(const IntVector &lhs, const IntVector &rhs, size_t partsNum);
+  size_t zerosMultiply(IntVector &lhs, IntVector &rhs);
+  IntVector unbalancedMultiply(const IntVector &lhs, const IntVector &rhs);
+  IntVector multiply(const IntVector &lhs, const IntVector &rhs);
+  IntVector square(const IntVector &rhs);
+
+  uint64_t inverseLimb(uint64_t rhs);
+  NttPrime makeNttPrime(uint64_t mod, uint64_t root);
+  const std::array<NttPrime, NTT_PRIMES_NUM> &getNttPrimes();
+  uint64_t montgomeryReduce(uint128_t val, const NttPrime &prime);
+  uint64_t montgomeryMultiply(uint64_t lhs, uint64_t rhs, const NttPrime &prime);
+  uint64_t montgomeryPow(uint64_t lhs, uint64_t rhs, const NttPrime &prime);
+  std::vector<uint64_t> getNttRoots(uint64_t root, size_t first, size_t last, const NttPrime &prime);
+  size_t getNttBlocksNum(size_t size);
+  void nttButterflies(uint64_t *vals, size_t size, size_t len, size_t first, size_t last, const uint64_t *roots,
+                      size_t rootsStep, const NttPrime &prime);
+  void inverseNttButterflies(uint64_t *vals, size_t size, size_t len, size_t first, size_t last, const uint64_t *roots,
+                             size_t rootsStep, const NttPrime &prime);
+  void ntt(std::vector<uint64_t> &vals, const NttPrime &prime);
+  void inverseNtt(std::vector<uint64_t> &vals, const NttPrime &prime);
+  std::vector<uint64_t> nttTransform(const IntVector &rhs, size_t size, const NttPrime &prime);
+  IntVector nttCombine(std::array<std::vector<uint64_t>, NTT_PRIMES_NUM> &vals, size_t resSize);
+  IntVector nttMultiply(const IntVector &lhs, const IntVector &rhs);
+  IntVector nttSquare(const IntVector &rhs);
+
+  IntVector shortDivide(const IntVector &lhs, uint64_t rhs);
+  IntVector shortDivide(const IntVector &lhs, uint64_t rhs, IntVector &modVal);
+  IntVector knuthDivide(const IntVector &lhs, const IntVector &rhs, IntVector &modVal);
+  IntVector getLimbs(const IntVector &rhs, size_t first, size_t limbsNum);
+  IntVector recursiveDivide(const IntVector &lhs, const IntVector &rhs, IntVector &modVal);
+  IntVector burnikelZieglerDivide(const IntVector &lhs, const IntVector &rhs, IntVector &modVal);
+  IntVector divide(const IntVector &lhs, const IntVector &rhs, IntVector &modVal);
+  IntVector exactDivide(const IntVector &lhs, const IntVector &rhs);
+
+  uint64_t shortSqrt(uint128_t rhs);
+  IntVector karatsubaSqrt(const IntVector &rhs, size_t limbsNum, IntVector &remVal);
   IntVector sqrt(const IntVector &rhs);
-  void getSqrtDiff(const IntVector &rhs, const int64_t &base, IntVector &val, IntVector &diff);
+  IntVector sqrt(const IntVector &rhs, IntVector &remVal);
+
+  uint64_t binaryGcd(uint64_t lhs, uint64_t rhs);
+  uint128_t binaryGcd(uint128_t lhs, uint128_t rhs);
+  uint64_t getBits(const IntVector &rhs, size_t first);
+  bool lehmerCofactors(const IntVector &lhs, const IntVector &rhs, std::array<int64_t, 4> &cofactors);
+  IntVector linearCombination(const IntVector &lhs, int64_t lhsCoeff, const IntVector &rhs, int64_t rhsCoeff);
+  GcdMatrix multiply(const GcdMatrix &lhs, const GcdMatrix &rhs);
+  void gcdStep(IntVector &lhs, IntVector &rhs, GcdMatrix *matrix);
+  void applyGcdMatrix(GcdMatrix step, IntVector &lhs, IntVector &rhs, GcdMatrix *matrix);
+  void halfGcd(IntVector &lhs, IntVector &rhs, GcdMatrix *matrix);
+  IntVector gcd(const IntVector &lhs, const IntVector &rhs);
+  IntVector gcdExtended(const IntVector &lhs, const IntVector &rhs, SignedIntVector &lhsFactor);
+
+  size_t getWindowSize(size_t bitsNum);
+  IntVector montgomeryReduce(IntVector val, const IntVector &mod, uint64_t modInv);
+  IntVector barrettReduce(const IntVector &val, const IntVector &mod, const IntVector &mu);
+
+  SignedIntVector signedAdd(const SignedIntVector &lhs, const SignedIntVector &rhs);
+  SignedIntVector signedSubstract(const SignedIntVector &lhs, const SignedIntVector &rhs);
+  SignedIntVector signedShortMultiply(const SignedIntVector &lhs, int64_t rhs);
+  SignedIntVector signedShortDivide(const SignedIntVector &lhs, int64_t rhs);
+
+  std::shared_ptr<ThreadPool> &getThreadPool();
+  void runTasks(const std::vector<std::function<void()>> &tasks, size_t size);
+  void runRangeTasks(size_t size, size_t rangeSize, const std::function<void(size_t, size_t)> &func);
 
   Integer::Integer(const std::string_view &str) {
     parse(str);
   }
 
-  Integer::Integer(int64_t val) : Integer(std::to_string(val)) {
+  Integer::Integer(int64_t val) : intVect{val < 0 ? 0 - uint64_t(val) : uint64_t(val)}, sign(val < 0) {
   }
 
+  /*
+    Number of decimal digits, that is floor(log10(|x|)) + 1. It is taken from the logarithm estimate, which is exact
+    enough unless the number is very close to a power of 10. Only then the number is compared with this power: first by
+    the bit lengths, then by the limbs of the cached power.
+  */
   int64_t Integer::getSize() const {
-    return int64_t((intVect.size() - 1) * INT_BASE_SIZE + (std::to_string(intVect.back())).size());
+    if (intVect.size() == 1 && zerosNum == 0 && intVect.front() < 10) {
+      return 1;
+    }
+
+    double log10Val = getLog10();
+    double nearestPow = std::round(log10Val);
+
+    if (std::abs(log10Val - nearestPow) > LOG_ESTIMATE_PRECISION) {
+      return int64_t(log10Val) + 1;
+    }
+
+    auto exp = size_t(nearestPow);
+    size_t bitsNum = getBitsNum();
+    size_t powBitsNum = decimalPowBitsNum(exp);
+
+    if (bitsNum != powBitsNum) {
+      return bitsNum < powBitsNum ? int64_t(exp) : int64_t(exp) + 1;
+    }
+    return compareShifted(intVect, zerosNum, decimalPow(exp), 0) < 0 ? int64_t(exp) : int64_t(exp) + 1;
+  }
+
+  size_t Integer::getLimbsNum() const {
+    return intVect.size() + zerosNum;
+  }
+
+  size_t Integer::getBitsNum() const {
+    if (intVect.back() == 0) {
+      return 0;
+    }
+    return (intVect.size() + zerosNum) * INT_BASE_SIZE - uint64_t(__builtin_clzll(intVect.back()));
+  }
+
+  // The highest two limbs are enough for the double precision
+  double Integer::getLog2() const {
+    if (intVect.back() == 0) {
+      return -HUGE_VAL;
+    }
+
+    double highVal = double(intVect.back());
+    double shift = double(zerosNum * INT_BASE_SIZE);
+    if (intVect.size() == 1) {
+      return std::log2(highVal) + shift;
+    }
+
+    highVal = highVal * std::ldexp(1, int(INT_BASE_SIZE)) + double(intVect[intVect.size() - 2]);
+    return std::log2(highVal) + double((intVect.size() - 2) * INT_BASE_SIZE) + shift;
+  }
+
+  double Integer::getLog10() const {
+    return getLog2() * std::log10(2);
   }
 
-  // Changing the number base to solve sqrt
   Integer Integer::sqrt() const {
     if (*this < 0) {
       throw std::domain_error("sqrt out of range");
     }
-    auto vect = toIntVector(toString(), 2);
-    return Integer(fintamath::toString(fintamath::sqrt(vect), 1));
+    Integer res;
+    res.intVect = fintamath::sqrt(getIntVector(0));
+    res.fixZero();
+    return res;
+  }
+
+  Integer Integer::sqrtRem(Integer &remainder) const {
+    if (*this < 0) {
+      throw std::domain_error("sqrt out of range");
+    }
+    Integer res;
+    IntVector remVal;
+    res.intVect = fintamath::sqrt(getIntVector(0), remVal);
+    res.fixZero();
+    remainder.intVect = std::move(remVal);
+    remainder.sign = false;
+    remainder.zerosNum = 0;
+    remainder.fixZero();
+    return res;
+  }
+
+  Integer Integer::square() const {
+    Integer res;
+    res.intVect = fintamath::square(intVect);
+    res.zerosNum = zerosNum * 2;
+    res.fixZero();
+    return res;
+  }
+
+  // Quotient and remainder of one division, the same as of the operators / and %
+  Integer Integer::divMod(const Integer &rhs, Integer &remainder) const {
+    if (rhs == 0) {
+      throw std::domain_error("Div by zero");
+    }
+
+    Integer res;
+    Integer remVal;
+
+    // The common low zero limbs are moved to the remainder
+    size_t commonZerosNum = std::min(zerosNum, rhs.zerosNum);
+    IntVector lhsVect = getIntVector(commonZerosNum);
+    IntVector rhsVect = rhs.getIntVector(commonZerosNum);
+
+    if (greater(rhsVect, lhsVect)) {
+      remVal = *this;
+    } else if (lhsVect.size() == 1 && rhsVect.size() == 1) {
+      res.intVect.front() = lhsVect.front() / rhsVect.front();
+      remVal.intVect.front() = lhsVect.front() % rhsVect.front();
+      remVal.zerosNum = commonZerosNum;
+    } else {
+      res.intVect = fintamath::divide(lhsVect, rhsVect, remVal.intVect);
+      remVal.zerosNum = commonZerosNum;
+    }
+
+    res.sign = sign != rhs.sign;
+    remVal.sign = sign;
+    res.fixZero();
+    remVal.fixZero();
+
+    remainder = std::move(remVal);
+    return res;
+  }
+
+  // Division of a number known to be divisible by rhs, the result is undefined otherwise
+  Integer Integer::divExact(const Integer &rhs) const {
+    if (rhs == 0) {
+      throw std::domain_error("Div by zero");
+    }
+
+    size_t commonZerosNum = std::min(zerosNum, rhs.zerosNum);
+    Integer res;
+    res.intVect = exactDivide(getIntVector(commonZerosNum), rhs.getIntVector(commonZerosNum));
+    res.sign = sign != rhs.sign;
+    res.fixZero();
+    return res;
+  }
+
+  // The common low zero limbs are the common factor BASE^k
+  Integer Integer::gcd(const Integer &rhs) const {
+    size_t commonZerosNum = std::min(zerosNum, rhs.zerosNum);
+    Integer res;
+    res.intVect = fintamath::gcd(getIntVector(commonZerosNum), rhs.getIntVector(commonZerosNum));
+    res.zerosNum = commonZerosNum;
+    res.fixZero();
+    return res;
+  }
+
+  // The factors satisfy lhs * lhsFactor + rhs * rhsFactor = gcd, the gcd is non-negative
+  Integer Integer::gcdExtended(const Integer &rhs, Integer &lhsFactor, Integer &rhsFactor) const {
+    SignedIntVector lhsFactorVal;
+    Integer res;
+    res.intVect = fintamath::gcdExtended(getIntVector(0), rhs.getIntVector(0), lhsFactorVal);
+    res.fixZero();
+
+    Integer tmpLhsFactor;
+    tmpLhsFactor.intVect = std::move(lhsFactorVal.intVect);
+    tmpLhsFactor.sign = lhsFactorVal.sign != sign;
+    tmpLhsFactor.fixZero();
+
+    Integer tmpRhsFactor = 0;
+    if (rhs != 0) {
+      tmpRhsFactor = (res - *this * tmpLhsFactor).divExact(rhs);
+    }
+
+    lhsFactor = std::move(tmpLhsFactor);
+    rhsFactor = std::move(tmpRhsFactor);
+    return res;
+  }
+
+  Integer Integer::powMod(const Integer &exp, const Integer &mod) const {
+    return ModContext(mod).powMod(*this, exp);
+  }
+
+  // 10^n = 5^n * 2^n is taken from the cached powers of DECIMAL_BASE, its whole zero limbs only increase zerosNum
+  Integer &Integer::shiftDecimalLeft(size_t n) {
+    Integer pow10;
+    pow10.intVect = decimalPow(n);
+    pow10.fixZero();
+    return multiply(pow10);
+  }
+
+  Integer &Integer::shiftDecimalRight(size_t n) {
+    Integer pow10 = 1;
+    pow10.shiftDecimalLeft(n);
+    return divide(pow10);
+  }
+
+  void Integer::setThreadsNum(size_t threadsNum) {
+    if (threadsNum == 0) {
+      throw std::invalid_argument("Threads number must be positive");
+    }
+    std::shared_ptr<ThreadPool> pool = threadsNum > 1 ? std::make_shared<ThreadPool>(threadsNum) : nullptr;
+    std::atomic_store(&getThreadPool(), std::move(pool));
+  }
+
+  size_t Integer::getThreadsNum() {
+    std::shared_ptr<ThreadPool> pool = std::atomic_load(&getThreadPool());
+    return pool ? pool->getThreadsNum() : 1;
   }
 
   Integer &Integer::operator%=(const Integer &rhs) {
@@ -75,7 +385,7 @@ namespace fintamath {
   }
 
   std::string Integer::toString() const {
-    std::string str = fintamath::toString(intVect, INT_BASE_SIZE);
+    std::string str = fintamath::toString(getIntVector(0));
     if (str != "0" && sign) {
       str.insert(0, 1, '-');
     }
@@ -83,46 +393,52 @@ namespace fintamath {
   }
 
   bool Integer::equals(const Integer &rhs) const {
-    return sign == rhs.sign && equal(intVect, rhs.intVect);
+    return sign == rhs.sign && zerosNum == rhs.zerosNum && equal(intVect, rhs.intVect);
   }
 
-  bool Integer::less(const Integer &rhs) const {
-    if (!sign && rhs.sign) {
-      return false;
-    }
-    if (sign && !rhs.sign) {
-      return true;
-    }
-    if (sign) {
-      return fintamath::less(rhs.intVect, intVect);
+  int Integer::compare(const Integer &rhs) const {
+    if (sign != rhs.sign) {
+      return sign ? -1 : 1;
     }
-    return fintamath::less(intVect, rhs.intVect);
+    int res = compareShifted(intVect, zerosNum, rhs.intVect, rhs.zerosNum);
+    return sign ? -res : res;
   }
 
-  bool Integer::more(const Integer &rhs) const {
-    if (!sign && rhs.sign) {
-      return true;
-    }
-    if (sign && !rhs.sign) {
-      return false;
-    }
-    if (sign) {
-      return greater(rhs.intVect, intVect);
+  // Numbers with equal low zero limbs are added as they are, otherwise they are aligned first
+  Integer &Integer::add(const Integer &rhs) {
+    if (zerosNum != rhs.zerosNum) {
+      size_t commonZerosNum = std::min(zerosNum, rhs.zerosNum);
+      Integer tmpRhs = rhs;
+      tmpRhs.expandZeros(commonZerosNum);
+      expandZeros(commonZerosNum);
+      return add(tmpRhs);
     }
-    return greater(intVect, rhs.intVect);
-  }
 
-  Integer &Integer::add(const Integer &rhs) {
     if ((!sign && !rhs.sign) || (sign && rhs.sign)) {
-      intVect = addToSignificantDigits(intVect, rhs.intVect, INT_BASE);
+      if (intVect.size() == 1 && rhs.intVect.size() == 1) {
+        uint128_t sum = uint128_t(intVect.front()) + rhs.intVect.front();
+        intVect.front() = uint64_t(sum);
+        if (uint64_t carry = uint64_t(sum >> INT_BASE_SIZE); carry != 0) {
+          intVect.push_back(carry);
+        }
+      } else {
+        intVect = addToSignificantDigits(intVect, rhs.intVect);
+      }
     }
 
     else {
-      if (greater(intVect, rhs.intVect)) {
-        intVect = fintamath::substract(intVect, rhs.intVect, INT_BASE);
+      if (intVect.size() == 1 && rhs.intVect.size() == 1) {
+        if (intVect.front() >= rhs.intVect.front()) {
+          intVect.front() -= rhs.intVect.front();
+        } else {
+          sign = !sign;
+          intVect.front() = rhs.intVect.front() - intVect.front();
+        }
+      } else if (greater(intVect, rhs.intVect)) {
+        intVect = fintamath::substract(intVect, rhs.intVect);
       } else {
         sign = !sign;
-        intVect = fintamath::substract(rhs.intVect, intVect, INT_BASE);
+        intVect = fintamath::substract(rhs.intVect, intVect);
       }
     }
 
@@ -136,8 +452,24 @@ namespace fintamath {
     return *this += tmpRhs;
   }
 
+  // The low zero limbs of the factors are added up, so multiplication by a power of BASE only changes their number
   Integer &Integer::multiply(const Integer &rhs) {
-    intVect = fintamath::multiply(intVect, rhs.intVect, INT_BASE);
+    size_t resZerosNum = zerosNum + rhs.zerosNum;
+
+    if (rhs.intVect.size() == 1 && rhs.intVect.front() == 1) {
+      // Multiplication by a power of BASE
+    } else if (intVect.size() == 1 && intVect.front() == 1) {
+      intVect = rhs.intVect;
+    } else if (intVect.size() == 1 && rhs.intVect.size() == 1) {
+      uint128_t prod = uint128_t(intVect.front()) * rhs.intVect.front();
+      intVect.front() = uint64_t(prod);
+      if (uint64_t carry = uint64_t(prod >> INT_BASE_SIZE); carry != 0) {
+        intVect.push_back(carry);
+      }
+    } else {
+      intVect = fintamath::multiply(intVect, rhs.intVect);
+    }
+    zerosNum = resZerosNum;
     sign = !((sign && rhs.sign) || (!sign && !rhs.sign));
     fixZero();
     return *this;
@@ -150,14 +482,33 @@ namespace fintamath {
     if (*this == 0) {
       return *this;
     }
-    if (greater(rhs.intVect, intVect)) {
+
+    bool resSign = !((sign && rhs.sign) || (!sign && !rhs.sign));
+
+    // Division by a power of BASE
+    if (rhs.intVect.size() == 1 && rhs.intVect.front() == 1 && zerosNum >= rhs.zerosNum) {
+      zerosNum -= rhs.zerosNum;
+      sign = resSign;
+      return *this;
+    }
+
+    size_t commonZerosNum = std::min(zerosNum, rhs.zerosNum);
+    IntVector rhsVect = rhs.getIntVector(commonZerosNum);
+    intVect = getIntVector(commonZerosNum);
+    zerosNum = 0;
+
+    if (greater(rhsVect, intVect)) {
       *this = 0;
       return *this;
     }
 
-    IntVector modVal;
-    intVect = fintamath::divide(intVect, rhs.intVect, modVal, INT_BASE);
-    sign = !((sign && rhs.sign) || (!sign && !rhs.sign));
+    if (intVect.size() == 1 && rhsVect.size() == 1) {
+      intVect.front() /= rhsVect.front();
+    } else {
+      IntVector modVal;
+      intVect = fintamath::divide(intVect, rhsVect, modVal);
+    }
+    sign = resSign;
 
     fixZero();
     return *this;
@@ -183,11 +534,112 @@ namespace fintamath {
     if (*this == 0) {
       return *this;
     }
-    if (greater(rhs.intVect, intVect)) {
+
+    // The common low zero limbs stay in the remainder
+    size_t commonZerosNum = std::min(zerosNum, rhs.zerosNum);
+    IntVector rhsVect = rhs.getIntVector(commonZerosNum);
+    expandZeros(commonZerosNum);
+
+    if (greater(rhsVect, intVect)) {
+      fixZero();
+      return *this;
+    }
+
+    if (intVect.size() == 1 && rhsVect.size() == 1) {
+      intVect.front() %= rhsVect.front();
+    } else {
+      fintamath::divide(intVect, rhsVect, intVect);
+    }
+
+    fixZero();
+    return *this;
+  }
+
+  int Integer::compare(int64_t rhs) const {
+    bool rhsSign = rhs < 0;
+    if (sign != rhsSign) {
+      return sign ? -1 : 1;
+    }
+
+    uint64_t absRhs = rhsSign ? 0 - uint64_t(rhs) : uint64_t(rhs);
+    int res = 0;
+    if (intVect.size() > 1 || zerosNum != 0 || intVect.front() > absRhs) {
+      res = 1;
+    } else if (intVect.front() < absRhs) {
+      res = -1;
+    }
+    return sign ? -res : res;
+  }
+
+  Integer &Integer::add(int64_t rhs) {
+    return addShort(rhs < 0 ? 0 - uint64_t(rhs) : uint64_t(rhs), rhs < 0);
+  }
+
+  Integer &Integer::substract(int64_t rhs) {
+    return addShort(rhs < 0 ? 0 - uint64_t(rhs) : uint64_t(rhs), rhs >= 0);
+  }
+
+  Integer &Integer::multiply(int64_t rhs) {
+    intVect = shortMultiply(intVect, rhs < 0 ? 0 - uint64_t(rhs) : uint64_t(rhs));
+    sign = sign != (rhs < 0);
+    fixZero();
+    return *this;
+  }
+
+  Integer &Integer::divide(int64_t rhs) {
+    if (rhs == 0) {
+      throw std::domain_error("Div by zero");
+    }
+
+    expandZeros(0);
+    intVect = shortDivide(intVect, rhs < 0 ? 0 - uint64_t(rhs) : uint64_t(rhs));
+    sign = sign != (rhs < 0);
+    fixZero();
+    return *this;
+  }
+
+  Integer &Integer::mod(int64_t rhs) {
+    if (rhs == 0) {
+      throw std::domain_error("Div by zero");
+    }
+
+    expandZeros(0);
+    IntVector modVal;
+    shortDivide(intVect, rhs < 0 ? 0 - uint64_t(rhs) : uint64_t(rhs), modVal);
+    intVect = modVal;
+    fixZero();
+    return *this;
+  }
+
+  // Adding a number of one limb with the given sign
+  Integer &Integer::addShort(uint64_t rhs, bool rhsSign) {
+    if (rhs == 0) {
       return *this;
     }
 
-    fintamath::divide(intVect, rhs.intVect, intVect, INT_BASE);
+    expandZeros(0);
+
+    if (sign == rhsSign) {
+      uint64_t carry = rhs;
+      for (size_t i = 0; i < intVect.size() && carry != 0; i++) {
+        intVect[i] += carry;
+        carry = intVect[i] < carry ? 1 : 0;
+      }
+      if (carry != 0) {
+        intVect.push_back(carry);
+      }
+    } else if (intVect.size() == 1 && intVect.front() < rhs) {
+      intVect.front() = rhs - intVect.front();
+      sign = rhsSign;
+    } else {
+      uint64_t borrow = rhs;
+      for (size_t i = 0; i < intVect.size() && borrow != 0; i++) {
+        uint64_t limb = intVect[i];
+        intVect[i] -= borrow;
+        borrow = limb < borrow ? 1 : 0;
+      }
+      toSignificantDigits(intVect);
+    }
 
     fixZero();
     return *this;
@@ -211,444 +663,2116 @@ namespace fintamath {
       throw std::invalid_argument("Integer invalid input");
     }
 
-    intVect = toIntVector(str.substr(size_t(firstDigitNum)), INT_BASE_SIZE);
+    intVect = toIntVector(str.substr(size_t(firstDigitNum)));
+    zerosNum = 0;
+    fixZero();
   }
 
+  // Clearing the sign of zero and moving the low zero limbs to zerosNum
   void Integer::fixZero() {
     if (intVect.size() == 1 && intVect.front() == 0) {
       sign = false;
+      zerosNum = 0;
+    } else if (intVect.front() == 0) {
+      size_t num = firstZeroNum(intVect);
+      intVect.erase(intVect.begin(), intVect.begin() + ptrdiff_t(num));
+      zerosNum += num;
     }
   }
 
-  IntVector toIntVector(const std::string_view &str, int64_t baseSize) {
-    IntVector intVect;
-    std::basic_string_view<char>::const_iterator iter = str.end();
-    for (; std::distance(str.begin(), iter) > baseSize; iter -= baseSize) {
-      intVect.push_back(stoll(std::string(iter - baseSize, iter)));
+  // Limbs of the number with its low zero limbs except skippedZerosNum ones
+  IntVector Integer::getIntVector(size_t skippedZerosNum) const {
+    IntVector res = intVect;
+    if (zerosNum > skippedZerosNum) {
+      res.insert(res.begin(), zerosNum - skippedZerosNum, 0);
     }
-    intVect.push_back(stoll(std::string(str.begin(), iter)));
-    toSignificantDigits(intVect);
-    return intVect;
-  }
-
-  bool canConvert(const std::string_view &str) {
-    const int64_t firstDigit = 0;
-    const int64_t lastDigit = 9;
-    return std::all_of(str.begin(), str.end(),
-                       [&](auto ch) { return ch - '0' >= firstDigit && ch - '0' <= lastDigit; });
+    return res;
   }
 
-  std::string toString(const IntVector &intVect, int64_t baseSize) {
-    std::string str = std::to_string(intVect.back());
-    if (intVect.size() == 1) {
-      return str;
-    }
-    for (size_t i = intVect.size() - 2; i != SIZE_MAX; i--) {
-      std::string tmp = std::to_string(intVect[i]);
-      tmp.insert(0, size_t(baseSize) - tmp.size(), '0');
-      str.insert(str.size(), tmp);
+  // Moving the low zero limbs back to intVect, so that only newZerosNum of them are left
+  void Integer::expandZeros(size_t newZerosNum) {
+    if (zerosNum > newZerosNum) {
+      intVect.insert(intVect.begin(), zerosNum - newZerosNum, 0);
+      zerosNum = newZerosNum;
     }
-    return str;
   }
 
-  // Finding a digit before the first non-zero digit, starting with the lowest digits
-  int64_t firstZeroNum(const IntVector &rhs) {
-    size_t num = 0;
-    while (num < rhs.size() && rhs[num] == 0) {
-      num++;
+  ModContext::ModContext(const Integer &rhs) : mod(rhs) {
+    if (mod == 0) {
+      throw std::domain_error("Div by zero");
     }
-    return int64_t(num);
-  }
+    mod.sign = false;
+    modVect = mod.getIntVector(0);
 
-  void toSignificantDigits(IntVector &rhs) {
-    size_t i = rhs.size() - 1;
-    for (; i > 0; i--) {
-      if (rhs[i] != 0) {
-        break;
-      }
-    }
-    rhs.resize(i + 1);
-  }
+    IntVector basePow(modVect.size() * 2 + 1, 0);
+    basePow.back() = 1;
 
-  // If the value in the given digit >= INT_BASE, the surplus is added to the next digit
-  void toBasePositive(IntVector &rhs, size_t pos, int64_t base) {
-    if (rhs[pos] >= base) {
-      rhs[pos + 1] += rhs[pos] / base;
-      rhs[pos] %= base;
+    isMontgomery = modVect.front() % 2 == 1 && modVect.size() < MONTGOMERY_CUTOFF;
+    if (isMontgomery) {
+      modInv = 0 - inverseLimb(modVect.front());
+      divide(basePow, modVect, r2);
+    } else {
+      IntVector modVal;
+      mu = divide(basePow, modVect, modVal);
     }
   }
 
-  // If the value in the given digit < 0, then the deficiency is subtracted from the next digit
-  void toBaseNegative(IntVector &rhs, size_t pos, int64_t base) {
-    if (rhs[pos] < 0) {
-      rhs[pos + 1]--;
-      rhs[pos] += base;
-    }
+  const Integer &ModContext::getMod() const {
+    return mod;
   }
 
-  bool equal(const IntVector &lhs, const IntVector &rhs) {
-    if (lhs.size() != rhs.size()) {
-      return false;
+  /*
+    Modular exponentiation by the sliding window method. The odd powers of the base up to 2^w are precomputed, then the
+    exponent is scanned from the highest bit: zero bits are squarings, a window of at most w bits ending with 1 is w
+    squarings and one multiplication by the precomputed power. A negative exponent is a power of the modular inverse.
+  */
+  Integer ModContext::powMod(const Integer &base, const Integer &exp) const {
+    Integer tmpBase = base % mod;
+    if (tmpBase < 0) {
+      tmpBase += mod;
     }
 
-    for (size_t i = lhs.size() - 1; i != SIZE_MAX; i--) {
-      if (lhs[i] != rhs[i]) {
-        return false;
+    if (exp < 0) {
+      Integer inv;
+      Integer tmp;
+      if (tmpBase.gcdExtended(mod, inv, tmp) != 1) {
+        throw std::domain_error("powMod out of range");
       }
+      return powMod(inv, -exp);
     }
 
-    return true;
-  }
-
-  bool less(const IntVector &lhs, const IntVector &rhs) {
-    if (lhs.size() > rhs.size()) {
-      return false;
+    Integer res;
+    if (mod == 1) {
+      return res;
     }
-    if (lhs.size() < rhs.size()) {
-      return true;
+    if (exp == 0) {
+      return 1;
     }
 
-    for (size_t i = lhs.size() - 1; i != SIZE_MAX; i--) {
-      if (lhs[i] > rhs[i]) {
-        return false;
-      }
-      if (lhs[i] < rhs[i]) {
-        return true;
+    IntVector expVect = exp.getIntVector(0);
+    auto getBit = [&expVect](size_t index) { return (expVect[index / INT_BASE_SIZE] >> (index % INT_BASE_SIZE)) & 1; };
+    size_t bitsNum = exp.getBitsNum();
+    size_t windowSize = getWindowSize(bitsNum);
+
+    // powers[i] = base^(2i + 1)
+    std::vector<IntVector> powers(size_t(1) << (windowSize - 1));
+    powers.front() = toForm(tmpBase.getIntVector(0));
+    if (powers.size() > 1) {
+      IntVector baseSquare = multiplyForm(powers.front(), powers.front());
+      for (size_t i = 1; i < powers.size(); i++) {
+        powers[i] = multiplyForm(powers[i - 1], baseSquare);
       }
     }
 
-    return false;
-  }
+    IntVector val;
+    bool isFirst = true;
 
-  bool greater(const IntVector &lhs, const IntVector &rhs) {
-    if (lhs.size() > rhs.size()) {
-      return true;
-    }
-    if (lhs.size() < rhs.size()) {
-      return false;
-    }
+    for (size_t i = bitsNum; i > 0;) {
+      if (getBit(i - 1) == 0) {
+        val = multiplyForm(val, val);
+        i--;
+        continue;
+      }
 
-    for (size_t i = lhs.size() - 1; i != SIZE_MAX; i--) {
-      if (lhs[i] > rhs[i]) {
-        return true;
+      size_t last = i > windowSize ? i - windowSize : 0;
+      while (getBit(last) == 0) {
+        last++;
       }
-      if (lhs[i] < rhs[i]) {
-        return false;
+
+      size_t window = 0;
+      for (size_t j = i; j > last; j--) {
+        window = window * 2 + getBit(j - 1);
+        if (!isFirst) {
+          val = multiplyForm(val, val);
+        }
       }
+
+      val = isFirst ? powers[window / 2] : multiplyForm(val, powers[window / 2]);
+      isFirst = false;
+      i = last;
     }
 
-    return false;
+    res.intVect = fromForm(val);
+    res.fixZero();
+    return res;
   }
 
-  // Column addition without reduction to significant digits
-  IntVector add(const IntVector &lhs, const IntVector &rhs, int64_t base) {
-    IntVector val = lhs;
-    if (rhs.size() > val.size()) {
-      val.resize(rhs.size(), 0);
-    }
-    val.push_back(0);
-
-    for (size_t i = 0; i < rhs.size(); i++) {
-      val[i] += rhs[i];
-      toBasePositive(val, i, base);
-    }
-    for (size_t i = rhs.size(); i < val.size(); i++) {
-      toBasePositive(val, i, base);
-    }
+  // Montgomery's form is rhs * BASE^n modulo mod, Barrett's reduction works with the residues themselves
+  IntVector ModContext::toForm(const IntVector &rhs) const {
+    return isMontgomery ? montgomeryReduce(multiply(rhs, r2), modVect, modInv) : rhs;
+  }
 
-    return val;
+  IntVector ModContext::fromForm(const IntVector &rhs) const {
+    return isMontgomery ? montgomeryReduce(rhs, modVect, modInv) : rhs;
   }
 
-  // Column addition with reduction to significant digits
-  IntVector addToSignificantDigits(const IntVector &lhs, const IntVector &rhs, int64_t base) {
-    IntVector val = add(lhs, rhs, base);
-    toSignificantDigits(val);
-    return val;
+  IntVector ModContext::multiplyForm(const IntVector &lhs, const IntVector &rhs) const {
+    IntVector val = multiply(lhs, rhs);
+    return isMontgomery ? montgomeryReduce(std::move(val), modVect, modInv) : barrettReduce(val, modVect, mu);
   }
 
-  // Column substraction
-  IntVector substract(const IntVector &lhs, const IntVector &rhs, int64_t base) {
-    IntVector val = lhs;
+  // DECIMAL_BASE^(2^level). The powers are cached and calculated by repeated squaring
+  const IntVector &getDecimalBasePow(size_t level) {
+    thread_local std::vector<IntVector> powers{IntVector{DECIMAL_BASE}};
 
-    for (size_t i = 0; i < rhs.size(); i++) {
-      val[i] -= rhs[i];
-      toBaseNegative(val, i, base);
-    }
-    for (size_t i = rhs.size(); i < val.size(); i++) {
-      toBaseNegative(val, i, base);
+    while (powers.size() <= level) {
+      IntVector val = multiply(powers.back(), powers.back());
+      powers.push_back(std::move(val));
     }
 
-    toSignificantDigits(val);
-    return val;
+    return powers[level];
   }
 
-  // Multiplication by a short number
-  IntVector shortMultiply(const IntVector &lhs, int64_t rhs, int64_t base) {
-    IntVector val;
-    val.resize(lhs.size() + 1, 0);
+  /*
+    10^exp as the product of the cached powers of DECIMAL_BASE by the remaining short power of 10. The last power is
+    cached too, as the same power is usually needed repeatedly. The reference is valid until the next call.
+  */
+  const IntVector &decimalPow(size_t exp) {
+    thread_local size_t cachedExp = 0;
+    thread_local IntVector cachedPow{1};
 
-    for (size_t i = 0; i < lhs.size(); i++) {
-      val[i] += lhs[i] * rhs;
-      toBasePositive(val, i, base);
+    if (exp == cachedExp) {
+      return cachedPow;
     }
 
+    uint64_t lowPow = 1;
+    for (size_t i = 0; i < exp % DECIMAL_BASE_SIZE; i++) {
+      lowPow *= 10;
+    }
+
+    IntVector res{lowPow};
+    size_t highExp = exp / DECIMAL_BASE_SIZE;
+
+    for (size_t level = 0; highExp != 0; level++, highExp /= 2) {
+      if (highExp % 2 == 1) {
+        const IntVector &basePow = getDecimalBasePow(level);
+        res = multiply(res, basePow);
+      }
+    }
+
+    cachedPow = std::move(res);
+    cachedExp = exp;
+    return cachedPow;
+  }
+
+  // Bit length of 10^exp, that is floor(exp * log2(10)) + 1, where log2(10) is taken with 126 fractional bits
+  size_t decimalPowBitsNum(size_t exp) {
+    uint128_t low = uint128_t(exp) * LOG2_10_LOW;
+    uint128_t high = uint128_t(exp) * LOG2_10_HIGH + (low >> INT_BASE_SIZE);
+    return size_t(high >> (INT_BASE_SIZE - 2)) + 1;
+  }
+
+  /*
+    Long strings are split into the high part and the low DECIMAL_BASE_SIZE * 2^k digits, where the low part is about
+    a half of the string. The parts are converted recursively and combined as high * DECIMAL_BASE^(2^k) + low.
+  */
+  IntVector toIntVector(const std::string_view &str) {
+    if (str.size() > PARSE_CUTOFF * DECIMAL_BASE_SIZE) {
+      size_t level = 0;
+      while ((DECIMAL_BASE_SIZE << (level + 2)) < str.size()) {
+        level++;
+      }
+      size_t lowSize = DECIMAL_BASE_SIZE << level;
+
+      // The recursive calls can add powers to the cache, so the power is taken only after them
+      IntVector highVal = toIntVector(str.substr(0, str.size() - lowSize));
+      const IntVector &basePow = getDecimalBasePow(level);
+      IntVector val = multiply(highVal, basePow);
+      addShifted(val, toIntVector(str.substr(str.size() - lowSize)), 0);
+      toSignificantDigits(val);
+      return val;
+    }
+
+    // Short strings are read in blocks of DECIMAL_BASE_SIZE digits, starting with the highest ones
+    IntVector intVect{0};
+
+    size_t blockSize = str.size() % DECIMAL_BASE_SIZE;
+    if (blockSize == 0) {
+      blockSize = DECIMAL_BASE_SIZE;
+    }
+
+    for (size_t pos = 0; pos < str.size(); pos += blockSize, blockSize = DECIMAL_BASE_SIZE) {
+      uint64_t block = 0;
+      uint64_t blockBase = 1;
+      for (size_t i = pos; i < pos + blockSize; i++) {
+        block = block * 10 + uint64_t(str[i] - '0');
+        blockBase *= 10;
+      }
+
+      uint64_t carry = block;
+      for (auto &limb : intVect) {
+        uint128_t val = uint128_t(limb) * blockBase + carry;
+        limb = uint64_t(val);
+        carry = uint64_t(val >> INT_BASE_SIZE);
+      }
+      if (carry != 0) {
+        intVect.push_back(carry);
+      }
+    }
+
+    return intVect;
+  }
+
+  bool canConvert(const std::string_view &str) {
+    const int64_t firstDigit = 0;
+    const int64_t lastDigit = 9;
+    return !str.empty() && std::all_of(str.begin(), str.end(), [&](auto ch) {
+      return ch - '0' >= firstDigit && ch - '0' <= lastDigit;
+    });
+  }
+
+  /*
+    Long numbers are divided by DECIMAL_BASE^(2^k) of about a half of their size, the quotient and the remainder are
+    converted recursively. Short ones are converted by blocks of DECIMAL_BASE_SIZE digits, which are obtained as
+    remainders of the division by DECIMAL_BASE.
+  */
+  std::string toString(const IntVector &intVect) {
+    if (intVect.size() > TO_STRING_CUTOFF) {
+      size_t level = 0;
+      while (getDecimalBasePow(level + 1).size() * 2 <= intVect.size()) {
+        level++;
+      }
+
+      const IntVector &basePow = getDecimalBasePow(level);
+      IntVector modVal;
+      std::string str = toString(divide(intVect, basePow, modVal));
+      std::string lowStr = toString(modVal);
+      str.append((DECIMAL_BASE_SIZE << level) - lowStr.size(), '0');
+      return str + lowStr;
+    }
+
+    std::vector<uint64_t> blocks;
+    IntVector val = intVect;
+
+    while (val.size() > 1) {
+      IntVector modVal;
+      val = shortDivide(val, DECIMAL_BASE, modVal);
+      blocks.push_back(modVal.front());
+    }
+
+    std::string str = std::to_string(val.front());
+    for (auto iter = blocks.rbegin(); iter != blocks.rend(); ++iter) {
+      std::string tmp = std::to_string(*iter);
+      tmp.insert(0, DECIMAL_BASE_SIZE - tmp.size(), '0');
+      str += tmp;
+    }
+
+    return str;
+  }
+
+  // Finding a digit before the first non-zero digit, starting with the lowest digits
+  size_t firstZeroNum(const IntVector &rhs) {
+    size_t num = 0;
+    while (num < rhs.size() && rhs[num] == 0) {
+      num++;
+    }
+    return num;
+  }
+
+  // Comparison of lhs * BASE^lhsShift and rhs * BASE^rhsShift, both numbers are significant
+  int compareShifted(const IntVector &lhs, size_t lhsShift, const IntVector &rhs, size_t rhsShift) {
+    size_t lhsSize = lhs.size() + lhsShift;
+    size_t rhsSize = rhs.size() + rhsShift;
+    if (lhsSize != rhsSize) {
+      return lhsSize < rhsSize ? -1 : 1;
+    }
+
+    for (size_t i = lhsSize; i > 0; i--) {
+      uint64_t lhsLimb = i > lhsShift ? lhs[i - 1 - lhsShift] : 0;
+      uint64_t rhsLimb = i > rhsShift ? rhs[i - 1 - rhsShift] : 0;
+      if (lhsLimb != rhsLimb) {
+        return lhsLimb < rhsLimb ? -1 : 1;
+      }
+    }
+
+    return 0;
+  }
+
+  void toSignificantDigits(IntVector &rhs) {
+    size_t i = rhs.size() - 1;
+    for (; i > 0; i--) {
+      if (rhs[i] != 0) {
+        break;
+      }
+    }
+    rhs.resize(i + 1);
+  }
+
+  // Multiplication by 2^bitsNum
+  IntVector shiftLeft(const IntVector &lhs, uint64_t bitsNum) {
+    size_t limbsNum = bitsNum / INT_BASE_SIZE;
+    uint64_t shift = bitsNum % INT_BASE_SIZE;
+
+    IntVector val(limbsNum, 0);
+    val.reserve(limbsNum + lhs.size() + 1);
+
+    if (shift == 0) {
+      val.insert(val.end(), lhs.begin(), lhs.end());
+    } else {
+      uint64_t carry = 0;
+      for (auto limb : lhs) {
+        val.push_back((limb << shift) | carry);
+        carry = limb >> (INT_BASE_SIZE - shift);
+      }
+      val.push_back(carry);
+    }
+
+    toSignificantDigits(val);
+    return val;
+  }
+
+  // Division by 2^bitsNum
+  IntVector shiftRight(const IntVector &lhs, uint64_t bitsNum) {
+    size_t limbsNum = bitsNum / INT_BASE_SIZE;
+    uint64_t shift = bitsNum % INT_BASE_SIZE;
+
+    if (limbsNum >= lhs.size()) {
+      return IntVector{0};
+    }
+
+    IntVector val(lhs.begin() + int64_t(limbsNum), lhs.end());
+
+    if (shift != 0) {
+      for (size_t i = 0; i < val.size(); i++) {
+        val[i] >>= shift;
+        if (i + 1 < val.size()) {
+          val[i] |= val[i + 1] << (INT_BASE_SIZE - shift);
+        }
+      }
+    }
+
+    toSignificantDigits(val);
+    return val;
+  }
+
+  bool equal(const IntVector &lhs, const IntVector &rhs) {
+    if (lhs.size() != rhs.size()) {
+      return false;
+    }
+
+    for (size_t i = lhs.size() - 1; i != SIZE_MAX; i--) {
+      if (lhs[i] != rhs[i]) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool less(const IntVector &lhs, const IntVector &rhs) {
+    if (lhs.size() > rhs.size()) {
+      return false;
+    }
+    if (lhs.size() < rhs.size()) {
+      return true;
+    }
+
+    for (size_t i = lhs.size() - 1; i != SIZE_MAX; i--) {
+      if (lhs[i] > rhs[i]) {
+        return false;
+      }
+      if (lhs[i] < rhs[i]) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  bool greater(const IntVector &lhs, const IntVector &rhs) {
+    if (lhs.size() > rhs.size()) {
+      return true;
+    }
+    if (lhs.size() < rhs.size()) {
+      return false;
+    }
+
+    for (size_t i = lhs.size() - 1; i != SIZE_MAX; i--) {
+      if (lhs[i] > rhs[i]) {
+        return true;
+      }
+      if (lhs[i] < rhs[i]) {
+        return false;
+      }
+    }
+
+    return false;
+  }
+
+  // Column addition without reduction to significant digits
+  IntVector add(const IntVector &lhs, const IntVector &rhs) {
+    IntVector val = lhs;
+    if (rhs.size() > val.size()) {
+      val.resize(rhs.size(), 0);
+    }
+    val.push_back(0);
+
+    addLimbs(val.data(), val.size(), rhs.data(), rhs.size());
+    return val;
+  }
+
+  // Column addition with reduction to significant digits
+  IntVector addToSignificantDigits(const IntVector &lhs, const IntVector &rhs) {
+    IntVector val = add(lhs, rhs);
+    toSignificantDigits(val);
+    return val;
+  }
+
+  // Addition of rhs multiplied by 2^(64 * offset) in place, without reduction to significant digits
+  void addShifted(IntVector &lhs, const IntVector &rhs, size_t offset) {
+    if (lhs.size() < offset + rhs.size() + 1) {
+      lhs.resize(offset + rhs.size() + 1, 0);
+    }
+
+    if (addLimbs(lhs.data() + offset, lhs.size() - offset, rhs.data(), rhs.size()) != 0) {
+      lhs.push_back(1);
+    }
+  }
+
+  // Column substraction, lhs must be not less than rhs
+  IntVector substract(const IntVector &lhs, const IntVector &rhs) {
+    IntVector val = lhs;
+    size_t rhsSize = std::min(rhs.size(), val.size());
+
+    substractLimbs(val.data(), val.size(), rhs.data(), rhsSize);
+
+    toSignificantDigits(val);
+    return val;
+  }
+
+  // Multiplication by a short number
+  IntVector shortMultiply(const IntVector &lhs, uint64_t rhs) {
+    IntVector val;
+    val.resize(lhs.size() + 1, 0);
+
+    uint64_t carry = 0;
+    for (size_t i = 0; i < lhs.size(); i++) {
+      uint128_t prod = uint128_t(lhs[i]) * rhs + carry;
+      val[i] = uint64_t(prod);
+      carry = uint64_t(prod >> INT_BASE_SIZE);
+    }
+    val.back() = carry;
+
+    toSignificantDigits(val);
+    return val;
+  }
+
+  /*
+    Multiplication of numbers in the form of polynomials without reduction to significant digits. The result of
+    lhsSize + rhsSize digits is written to res
+  */
+  void polynomialMultiply(const uint64_t *lhs, size_t lhsSize, const uint64_t *rhs, size_t rhsSize, uint64_t *res) {
+    std::fill(res, res + lhsSize + rhsSize, 0);
+
+    for (size_t i = 0; i < lhsSize; i++) {
+      uint64_t carry = 0;
+      for (size_t j = 0; j < rhsSize; j++) {
+        uint128_t prod = uint128_t(lhs[i]) * rhs[j] + res[i + j] + carry;
+        res[i + j] = uint64_t(prod);
+        carry = uint64_t(prod >> INT_BASE_SIZE);
+      }
+      res[i + rhsSize] = carry;
+    }
+  }
+
+  IntVector polynomialMultiply(const IntVector &lhs, const IntVector &rhs) {
+    IntVector res(lhs.size() + rhs.size(), 0);
+    polynomialMultiply(lhs.data(), lhs.size(), rhs.data(), rhs.size(), res.data());
+    return res;
+  }
+
+  // Adding rhs to lhs in place, rhsSize <= lhsSize. Returns the carry out of lhs
+  uint64_t addLimbs(uint64_t *lhs, size_t lhsSize, const uint64_t *rhs, size_t rhsSize) {
+    uint64_t carry = getLimbsKernels().add(lhs, lhs, rhs, rhsSize, 0);
+    for (size_t i = rhsSize; i < lhsSize && carry != 0; i++) {
+      lhs[i]++;
+      carry = lhs[i] == 0 ? 1 : 0;
+    }
+    return carry;
+  }
+
+  // Substracting rhs from lhs in place, rhsSize <= lhsSize. Returns the borrow out of lhs
+  uint64_t substractLimbs(uint64_t *lhs, size_t lhsSize, const uint64_t *rhs, size_t rhsSize) {
+    uint64_t borrow = getLimbsKernels().substract(lhs, lhs, rhs, rhsSize, 0);
+    for (size_t i = rhsSize; i < lhsSize && borrow != 0; i++) {
+      borrow = lhs[i] == 0 ? 1 : 0;
+      lhs[i]--;
+    }
+    return borrow;
+  }
+
+  /*
+    Writing |lhs - rhs| to res of lhsSize digits, rhsSize <= lhsSize. Returns true if rhs is greater than lhs
+  */
+  bool absDiffLimbs(const uint64_t *lhs, size_t lhsSize, const uint64_t *rhs, size_t rhsSize, uint64_t *res) {
+    bool isRhsGreater = false;
+    size_t i = lhsSize - 1;
+    while (i != SIZE_MAX && (i < rhsSize ? lhs[i] == rhs[i] : lhs[i] == 0)) {
+      i--;
+    }
+    if (i != SIZE_MAX && i < rhsSize) {
+      isRhsGreater = lhs[i] < rhs[i];
+    }
+
+    if (isRhsGreater) {
+      std::copy(rhs, rhs + rhsSize, res);
+      std::fill(res + rhsSize, res + lhsSize, 0);
+      substractLimbs(res, lhsSize, lhs, lhsSize);
+    } else {
+      std::copy(lhs, lhs + lhsSize, res);
+      substractLimbs(res, lhsSize, rhs, rhsSize);
+    }
+
+    return isRhsGreater;
+  }
+
+  // Size of the scratch area needed by karatsubaMultiply for numbers of the given size
+  size_t karatsubaScratchSize(size_t size) {
+    if (size < KARATSUBA_CUTOFF) {
+      return 0;
+    }
+    size_t highSize = size - size / 2;
+    return highSize * 4 + std::max(karatsubaScratchSize(highSize), size_t(1));
+  }
+
+  /*
+    Multiplication of numbers A by B of the same size n by Karatsuba's method. Recursively applied until the size of
+    the numbers is less than KARATSUBA_CUTOFF
+
+    A * B = p0 + p1 * 2^(64m) + p2 * 2^(128m)
+
+    p0 = A0 * B0
+    p1 = p0 + p2 - (A1 - A0)(B1 - B0)
+    p2 = A1 * B1
+
+    A0 and B0 - the first m = n / 2 digits of numbers
+    A1 and B1 - the remaining digits of numbers
+
+    p0 and p2 are written to the result directly. The differences, their product and p1 are calculated in the scratch
+    area, the recursive calls use the rest of it, so there are no allocations during the recursion.
+  */
+  void karatsubaMultiply(const uint64_t *lhs, const uint64_t *rhs, size_t size, uint64_t *res, uint64_t *scratch) {
+    if (size < KARATSUBA_CUTOFF) {
+      polynomialMultiply(lhs, size, rhs, size, res);
+      return;
+    }
+
+    size_t lowSize = size / 2;
+    size_t highSize = size - lowSize;
+
+    karatsubaMultiply(lhs, rhs, lowSize, res, scratch);
+    karatsubaMultiply(lhs + lowSize, rhs + lowSize, highSize, res + lowSize * 2, scratch);
+
+    uint64_t *prod = scratch;
+    uint64_t *lhsDiff = scratch + highSize * 2;
+    uint64_t *rhsDiff = scratch + highSize * 3;
+
+    bool isProdNegative = absDiffLimbs(lhs + lowSize, highSize, lhs, lowSize, lhsDiff) !=
+                          absDiffLimbs(rhs + lowSize, highSize, rhs, lowSize, rhsDiff);
+    karatsubaMultiply(lhsDiff, rhsDiff, highSize, prod, scratch + highSize * 4);
+
+    // The differences are no longer needed, p1 is calculated in their place
+    uint64_t *mid = scratch + highSize * 2;
+    size_t midSize = highSize * 2 + 1;
+    std::copy(res + lowSize * 2, res + size * 2, mid);
+    mid[midSize - 1] = 0;
+    addLimbs(mid, midSize, res, lowSize * 2);
+
+    if (isProdNegative) {
+      addLimbs(mid, midSize, prod, highSize * 2);
+    } else {
+      substractLimbs(mid, midSize, prod, highSize * 2);
+    }
+
+    addLimbs(res + lowSize, size * 2 - lowSize, mid, midSize);
+  }
+
+  /*
+    Multiplication of lhs by not longer rhs. The low rhs.size() digits of lhs are multiplied by rhs by Karatsuba's
+    method, the remaining high ones are multiplied by rhs separately, so rhs is never padded with zeros.
+  */
+  IntVector karatsubaMultiply(const IntVector &lhs, const IntVector &rhs) {
+    IntVector res(lhs.size() + rhs.size(), 0);
+    std::vector<uint64_t> scratch(karatsubaScratchSize(rhs.size()));
+    karatsubaMultiply(lhs.data(), rhs.data(), rhs.size(), res.data(), scratch.data());
+
+    if (lhs.size() > rhs.size()) {
+      addShifted(res, multiply(getLimbs(lhs, rhs.size(), lhs.size() - rhs.size()), rhs), rhs.size());
+    }
+
+    return res;
+  }
+
+  /*
+    Squaring of a number in the form of polynomial. Each product of different digits appears twice in the square, so it
+    is calculated once and the sum is doubled, then the squares of digits are added
+  */
+  void polynomialSquare(const uint64_t *rhs, size_t size, uint64_t *res) {
+    std::fill(res, res + size * 2, 0);
+
+    for (size_t i = 0; i < size; i++) {
+      uint64_t carry = 0;
+      for (size_t j = i + 1; j < size; j++) {
+        uint128_t prod = uint128_t(rhs[i]) * rhs[j] + res[i + j] + carry;
+        res[i + j] = uint64_t(prod);
+        carry = uint64_t(prod >> INT_BASE_SIZE);
+      }
+      res[i + size] = carry;
+    }
+
+    for (size_t i = size * 2 - 1; i > 0; i--) {
+      res[i] = (res[i] << 1) | (res[i - 1] >> (INT_BASE_SIZE - 1));
+    }
+    res[0] <<= 1;
+
+    uint64_t carry = 0;
+    for (size_t i = 0; i < size; i++) {
+      uint128_t prod = uint128_t(rhs[i]) * rhs[i];
+      uint128_t sum = uint128_t(res[i * 2]) + uint64_t(prod) + carry;
+      res[i * 2] = uint64_t(sum);
+      sum = uint128_t(res[i * 2 + 1]) + uint64_t(prod >> INT_BASE_SIZE) + uint64_t(sum >> INT_BASE_SIZE);
+      res[i * 2 + 1] = uint64_t(sum);
+      carry = uint64_t(sum >> INT_BASE_SIZE);
+    }
+  }
+
+  /*
+    Squaring of number A by Karatsuba's method, the same as karatsubaMultiply with B = A:
+
+    A^2 = p0 + p1 * 2^(64m) + p2 * 2^(128m)
+
+    p0 = A0^2
+    p1 = p0 + p2 - (A1 - A0)^2
+    p2 = A1^2
+
+    All three products are squares, so the recursion stays in squaring.
+  */
+  void karatsubaSquare(const uint64_t *rhs, size_t size, uint64_t *res, uint64_t *scratch) {
+    if (size < KARATSUBA_CUTOFF) {
+      polynomialSquare(rhs, size, res);
+      return;
+    }
+
+    size_t lowSize = size / 2;
+    size_t highSize = size - lowSize;
+
+    karatsubaSquare(rhs, lowSize, res, scratch);
+    karatsubaSquare(rhs + lowSize, highSize, res + lowSize * 2, scratch);
+
+    uint64_t *prod = scratch;
+    uint64_t *diff = scratch + highSize * 2;
+
+    absDiffLimbs(rhs + lowSize, highSize, rhs, lowSize, diff);
+    karatsubaSquare(diff, highSize, prod, scratch + highSize * 4);
+
+    uint64_t *mid = scratch + highSize * 2;
+    size_t midSize = highSize * 2 + 1;
+    std::copy(res + lowSize * 2, res + size * 2, mid);
+    mid[midSize - 1] = 0;
+    addLimbs(mid, midSize, res, lowSize * 2);
+    substractLimbs(mid, midSize, prod, highSize * 2);
+
+    addLimbs(res + lowSize, size * 2 - lowSize, mid, midSize);
+  }
+
+  // Splitting a number into partsNum parts of partSize digits, starting with the lowest digits
+  std::vector<IntVector> splitToParts(const IntVector &rhs, size_t partSize, size_t partsNum) {
+    std::vector<IntVector> parts;
+
+    for (size_t i = 0; i < partsNum; i++) {
+      size_t first = std::min(i * partSize, rhs.size());
+      size_t last = std::min(first + partSize, rhs.size());
+
+      if (first == last) {
+        parts.emplace_back(IntVector{0});
+        continue;
+      }
+
+      parts.emplace_back(rhs.begin() + first, rhs.begin() + last);
+      toSignificantDigits(parts.back());
+    }
+
+    return parts;
+  }
+
+  // Evaluating a polynomial with non-negative coefficients at the point by Horner's method
+  SignedIntVector evaluatePolynomial(const std::vector<IntVector> &coeffs, int64_t point) {
+    SignedIntVector val{coeffs.back(), false};
+    for (size_t i = coeffs.size() - 2; i != SIZE_MAX; i--) {
+      val = signedAdd(signedShortMultiply(val, point), SignedIntVector{coeffs[i], false});
+    }
+    return val;
+  }
+
+  /*
+    Multiplication of numbers A by B by Toom-Cook method with k = partsNum. Numbers are split into k parts of m
+    digits and considered as polynomials A(x) and B(x) of degree k - 1, where x = 2^(64m).
+
+    1. Evaluate A(x) and B(x) at 2k - 2 points 0, 1, -1, 2, -2, ... and multiply the values recursively. These are the
+    values of R(x) = A(x) * B(x) of degree 2k - 2. The highest coefficient of R is the product of the highest parts.
+
+    2. Substract the highest term from the values and find the remaining coefficients by Newton's interpolation.
+    Divided differences of a polynomial with integer coefficients at integer points are integers, so all the divisions
+    are exact.
+
+    3. Expand the Newton's form into coefficients and add them shifted by m digits each.
+  */
+  IntVector toomCookMultiply(const IntVector &lhs, const IntVector &rhs, size_t partsNum) {
+    bool isSquare = &lhs == &rhs;
+    size_t partSize = (std::max(lhs.size(), rhs.size()) + partsNum - 1) / partsNum;
+    std::vector<IntVector> lhsParts = splitToParts(lhs, partSize, partsNum);
+    std::vector<IntVector> rhsParts = isSquare ? lhsParts : splitToParts(rhs, partSize, partsNum);
+
+    size_t degree = partsNum * 2 - 2;
+    std::vector<int64_t> points(degree);
+    std::vector<SignedIntVector> lhsVals(degree);
+    std::vector<SignedIntVector> rhsVals(degree);
+
+    for (size_t i = 0; i < degree; i++) {
+      points[i] = i % 2 == 1 ? int64_t(i / 2 + 1) : -int64_t(i / 2);
+      lhsVals[i] = evaluatePolynomial(lhsParts, points[i]);
+      rhsVals[i] = isSquare ? lhsVals[i] : evaluatePolynomial(rhsParts, points[i]);
+    }
+
+    IntVector highCoeff;
+    std::vector<SignedIntVector> vals(degree);
+
+    std::vector<std::function<void()>> tasks;
+    tasks.emplace_back([&] { highCoeff = multiply(lhsParts.back(), rhsParts.back()); });
+    for (size_t i = 0; i < degree; i++) {
+      tasks.emplace_back([&, i] {
+        vals[i] = SignedIntVector{multiply(lhsVals[i].intVect, rhsVals[i].intVect), lhsVals[i].sign != rhsVals[i].sign};
+      });
+    }
+    runTasks(tasks, std::max(lhs.size(), rhs.size()));
+
+    for (size_t i = 0; i < degree; i++) {
+      SignedIntVector highVal{highCoeff, false};
+      for (size_t j = 0; j < degree; j++) {
+        highVal = signedShortMultiply(highVal, points[i]);
+      }
+      vals[i] = signedSubstract(vals[i], highVal);
+    }
+
+    for (size_t level = 1; level < degree; level++) {
+      for (size_t i = degree - 1; i >= level; i--) {
+        vals[i] = signedShortDivide(signedSubstract(vals[i], vals[i - 1]), points[i] - points[i - level]);
+      }
+    }
+
+    std::vector<SignedIntVector> coeffs(degree);
+    coeffs.back() = vals.back();
+    for (size_t i = degree - 2; i != SIZE_MAX; i--) {
+      for (size_t j = i; j + 1 < coeffs.size(); j++) {
+        coeffs[j] = signedSubstract(coeffs[j], signedShortMultiply(coeffs[j + 1], points[i]));
+      }
+      coeffs[i] = signedAdd(coeffs[i], vals[i]);
+    }
+
+    IntVector res = highCoeff;
+    res.insert(res.begin(), partSize * degree, 0);
+    for (size_t i = 0; i < coeffs.size(); i++) {
+      addShifted(res, coeffs[i].intVect, partSize * i);
+    }
+
+    toSignificantDigits(res);
+    return res;
+  }
+
+  // Multiplication of zero digits
+  size_t zerosMultiply(IntVector &lhs, IntVector &rhs) {
+    size_t lhsZerosNum = firstZeroNum(lhs);
+    size_t rhsZerosNum = firstZeroNum(rhs);
+
+    if (lhs.size() != 1) {
+      lhs.erase(lhs.begin(), lhs.begin() + int64_t(lhsZerosNum));
+    }
+    if (rhs.size() != 1) {
+      rhs.erase(rhs.begin(), rhs.begin() + int64_t(rhsZerosNum));
+    }
+
+    return lhsZerosNum + rhsZerosNum;
+  }
+
+  // Multiplication by the method chosen according to the sizes of the numbers
+  IntVector multiply(const IntVector &lhs, const IntVector &rhs) {
+    if (&lhs == &rhs || equal(lhs, rhs)) {
+      return square(lhs);
+    }
+
+    IntVector tmpLhs = lhs;
+    IntVector tmpRhs = rhs;
+    IntVector res;
+    size_t zerosNum = zerosMultiply(tmpLhs, tmpRhs);
+
+    if (tmpLhs.size() < tmpRhs.size()) {
+      std::swap(tmpLhs, tmpRhs);
+    }
+
+    if (tmpRhs.size() < KARATSUBA_CUTOFF) {
+      res = polynomialMultiply(tmpLhs, tmpRhs);
+    } else if (tmpLhs.size() >= tmpRhs.size() * 2 && (tmpLhs.size() < NTT_CUTOFF || tmpRhs.size() * 4 < NTT_CUTOFF)) {
+      // For long numbers one NTT of the whole product beats multiplying the parts, unless the short one is much shorter
+      res = unbalancedMultiply(tmpLhs, tmpRhs);
+    } else if (tmpLhs.size() >= NTT_CUTOFF) {
+      res = nttMultiply(tmpLhs, tmpRhs);
+    } else if (tmpLhs.size() >= TOOM_4_CUTOFF) {
+      res = toomCookMultiply(tmpLhs, tmpRhs, 4);
+    } else if (tmpLhs.size() >= TOOM_3_CUTOFF) {
+      res = toomCookMultiply(tmpLhs, tmpRhs, 3);
+    } else {
+      res = karatsubaMultiply(tmpLhs, tmpRhs);
+    }
+
+    res.insert(res.begin(), zerosNum, 0);
+    toSignificantDigits(res);
+    return res;
+  }
+
+  /*
+    Multiplication of long A by short B. A is split into parts of B.size() digits, each part is multiplied by B with
+    the balanced methods and added to the result with its offset. The short number is never padded with zeros to the
+    size of the long one.
+  */
+  IntVector unbalancedMultiply(const IntVector &lhs, const IntVector &rhs) {
+    std::vector<IntVector> products((lhs.size() + rhs.size() - 1) / rhs.size());
+
+    std::vector<std::function<void()>> tasks;
+    for (size_t i = 0; i < products.size(); i++) {
+      tasks.emplace_back([&, i] { products[i] = multiply(getLimbs(lhs, i * rhs.size(), rhs.size()), rhs); });
+    }
+    runTasks(tasks, lhs.size());
+
+    IntVector res(lhs.size() + rhs.size(), 0);
+    for (size_t i = 0; i < products.size(); i++) {
+      addShifted(res, products[i], i * rhs.size());
+    }
+
+    toSignificantDigits(res);
+    return res;
+  }
+
+  // Squaring with the same tiers as multiplication, each of them uses the symmetry of the operands
+  IntVector square(const IntVector &rhs) {
+    size_t zerosNum = firstZeroNum(rhs);
+    if (zerosNum == rhs.size()) {
+      return IntVector{0};
+    }
+
+    IntVector tmpRhs(rhs.begin() + zerosNum, rhs.end());
+    IntVector res;
+
+    if (tmpRhs.size() < KARATSUBA_CUTOFF) {
+      res.resize(tmpRhs.size() * 2);
+      polynomialSquare(tmpRhs.data(), tmpRhs.size(), res.data());
+    } else if (tmpRhs.size() >= NTT_CUTOFF) {
+      res = nttSquare(tmpRhs);
+    } else if (tmpRhs.size() >= TOOM_4_CUTOFF) {
+      res = toomCookMultiply(tmpRhs, tmpRhs, 4);
+    } else if (tmpRhs.size() >= TOOM_3_CUTOFF) {
+      res = toomCookMultiply(tmpRhs, tmpRhs, 3);
+    } else {
+      res.resize(tmpRhs.size() * 2);
+      std::vector<uint64_t> scratch(karatsubaScratchSize(tmpRhs.size()));
+      karatsubaSquare(tmpRhs.data(), tmpRhs.size(), res.data(), scratch.data());
+    }
+
+    res.insert(res.begin(), zerosNum * 2, 0);
+    toSignificantDigits(res);
+    return res;
+  }
+
+  // Inverse of an odd limb modulo 2^64 by Newton's iteration, each step doubles the number of correct bits
+  uint64_t inverseLimb(uint64_t rhs) {
+    uint64_t inv = rhs;
+    for (size_t i = 0; i < 5; i++) {
+      inv *= 2 - rhs * inv;
+    }
+    return inv;
+  }
+
+  NttPrime makeNttPrime(uint64_t mod, uint64_t root) {
+    NttPrime prime{mod, 0, 0, 0, 0};
+
+    prime.modInv = 0 - inverseLimb(mod);
+
+    auto r = uint64_t((uint128_t(1) << INT_BASE_SIZE) % mod);
+    prime.r2 = uint64_t(uint128_t(r) * r % mod);
+
+    prime.root = montgomeryMultiply(root, prime.r2, prime);
+    prime.rootInv = montgomeryPow(prime.root, mod - 2, prime);
+
+    return prime;
+  }
+
+  /*
+    Primes of the form c * 2^k + 1 with their primitive roots. Their product exceeds 2^188, so convolutions of up to
+    2^60 limbs are restored exactly by the Chinese remainder theorem.
+  */
+  const std::array<NttPrime, NTT_PRIMES_NUM> &getNttPrimes() {
+    static const std::array<NttPrime, NTT_PRIMES_NUM> primes = {
+        makeNttPrime(0x7E40000000000001, 6),
+        makeNttPrime(0x7740000000000001, 11),
+        makeNttPrime(0x6DC0000000000001, 3),
+    };
+    return primes;
+  }
+
+  // Montgomery's reduction: val * 2^(-64) modulo prime, val must be less than mod * 2^64
+  uint64_t montgomeryReduce(uint128_t val, const NttPrime &prime) {
+    uint64_t factor = uint64_t(val) * prime.modInv;
+    auto res = uint64_t((val + uint128_t(factor) * prime.mod) >> INT_BASE_SIZE);
+    return res >= prime.mod ? res - prime.mod : res;
+  }
+
+  uint64_t montgomeryMultiply(uint64_t lhs, uint64_t rhs, const NttPrime &prime) {
+    return montgomeryReduce(uint128_t(lhs) * rhs, prime);
+  }
+
+  uint64_t montgomeryPow(uint64_t lhs, uint64_t rhs, const NttPrime &prime) {
+    uint64_t res = montgomeryMultiply(1, prime.r2, prime);
+    for (; rhs != 0; rhs >>= 1) {
+      if ((rhs & 1) != 0) {
+        res = montgomeryMultiply(res, lhs, prime);
+      }
+      lhs = montgomeryMultiply(lhs, lhs, prime);
+    }
+    return res;
+  }
+
+  // Powers root^j of the root for j in [first, last)
+  std::vector<uint64_t> getNttRoots(uint64_t root, size_t first, size_t last, const NttPrime &prime) {
+    std::vector<uint64_t> roots(last - first);
+    uint64_t val = montgomeryPow(root, first, prime);
+    for (auto &rootVal : roots) {
+      rootVal = val;
+      val = montgomeryMultiply(val, root, prime);
+    }
+    return roots;
+  }
+
+  /*
+    Number of blocks the transforms are split into for the threads. There are several blocks per thread, so the threads
+    stay busy when some tasks take longer. The blocks are never more than the values in a block
+  */
+  size_t getNttBlocksNum(size_t size) {
+    size_t blocksNum = 1;
+    while (blocksNum < Integer::getThreadsNum() * 4 && blocksNum < NTT_BLOCK_CUTOFF &&
+           size / blocksNum >= NTT_BLOCK_CUTOFF * 2) {
+      blocksNum *= 2;
+    }
+    return blocksNum;
+  }
+
+  /*
+    Forward butterflies of length len on size values for j in [first, last). The root of the butterfly j is
+    roots[(j - first) * rootsStep]
+  */
+  void nttButterflies(uint64_t *vals, size_t size, size_t len, size_t first, size_t last, const uint64_t *roots,
+                      size_t rootsStep, const NttPrime &primeRef) {
+    const NttPrime prime = primeRef; // local copy, so the constants are not reloaded after each store to vals
+    size_t half = len / 2;
+
+    for (size_t i = 0; i < size; i += len) {
+      for (size_t j = first; j < last; j++) {
+        uint64_t lhs = vals[i + j];
+        uint64_t rhs = vals[i + j + half];
+        uint64_t sum = lhs + rhs;
+        vals[i + j] = sum >= prime.mod ? sum - prime.mod : sum;
+        vals[i + j + half] = montgomeryMultiply(lhs >= rhs ? lhs - rhs : lhs + prime.mod - rhs,
+                                                roots[(j - first) * rootsStep], prime);
+      }
+    }
+  }
+
+  // Inverse butterflies with the same arguments as the forward ones
+  void inverseNttButterflies(uint64_t *vals, size_t size, size_t len, size_t first, size_t last, const uint64_t *roots,
+                             size_t rootsStep, const NttPrime &primeRef) {
+    const NttPrime prime = primeRef;
+    size_t half = len / 2;
+
+    for (size_t i = 0; i < size; i += len) {
+      for (size_t j = first; j < last; j++) {
+        uint64_t lhs = vals[i + j];
+        uint64_t rhs = montgomeryMultiply(vals[i + j + half], roots[(j - first) * rootsStep], prime);
+        uint64_t sum = lhs + rhs;
+        vals[i + j] = sum >= prime.mod ? sum - prime.mod : sum;
+        vals[i + j + half] = lhs >= rhs ? lhs - rhs : lhs + prime.mod - rhs;
+      }
+    }
+  }
+
+  /*
+    Forward transform by Gentleman-Sande's scheme, the result is in bit-reversed order.
+
+    The values are split into blocks, one or several per task. Butterflies longer than a block cross the blocks, so
+    their ranges of j are split between the tasks. The shorter ones stay within a block and the blocks are transformed
+    independently. The roots of the shorter butterflies are every (blockSize / len)-th root of the block length.
+  */
+  void ntt(std::vector<uint64_t> &vals, const NttPrime &prime) {
+    size_t blocksNum = getNttBlocksNum(vals.size());
+    size_t blockSize = vals.size() / blocksNum;
+
+    for (size_t len = vals.size(); len > blockSize; len /= 2) {
+      uint64_t root = montgomeryPow(prime.root, (prime.mod - 1) / len, prime);
+      runRangeTasks(len / 2, len / 2 / blocksNum, [&, len, root](size_t first, size_t last) {
+        std::vector<uint64_t> roots = getNttRoots(root, first, last, prime);
+        nttButterflies(vals.data(), vals.size(), len, first, last, roots.data(), 1, prime);
+      });
+    }
+
+    uint64_t blockRoot = montgomeryPow(prime.root, (prime.mod - 1) / blockSize, prime);
+    std::vector<uint64_t> blockRoots = getNttRoots(blockRoot, 0, blockSize / 2, prime);
+
+    runRangeTasks(vals.size(), blockSize, [&](size_t first, size_t /*last*/) {
+      for (size_t len = blockSize; len >= 2; len /= 2) {
+        nttButterflies(vals.data() + first, blockSize, len, 0, len / 2, blockRoots.data(), blockSize / len, prime);
+      }
+    });
+  }
+
+  // Inverse transform by Cooley-Tukey's scheme from bit-reversed order, the blocks are the same as in the forward one
+  void inverseNtt(std::vector<uint64_t> &vals, const NttPrime &prime) {
+    size_t blocksNum = getNttBlocksNum(vals.size());
+    size_t blockSize = vals.size() / blocksNum;
+
+    uint64_t blockRoot = montgomeryPow(prime.rootInv, (prime.mod - 1) / blockSize, prime);
+    std::vector<uint64_t> blockRoots = getNttRoots(blockRoot, 0, blockSize / 2, prime);
+
+    runRangeTasks(vals.size(), blockSize, [&](size_t first, size_t /*last*/) {
+      for (size_t len = 2; len <= blockSize; len *= 2) {
+        inverseNttButterflies(vals.data() + first, blockSize, len, 0, len / 2, blockRoots.data(), blockSize / len,
+                              prime);
+      }
+    });
+
+    for (size_t len = blockSize * 2; len <= vals.size(); len *= 2) {
+      uint64_t root = montgomeryPow(prime.rootInv, (prime.mod - 1) / len, prime);
+      runRangeTasks(len / 2, len / 2 / blocksNum, [&, len, root](size_t first, size_t last) {
+        std::vector<uint64_t> roots = getNttRoots(root, first, last, prime);
+        inverseNttButterflies(vals.data(), vals.size(), len, first, last, roots.data(), 1, prime);
+      });
+    }
+
+    uint64_t sizeInv = montgomeryPow(montgomeryMultiply(vals.size(), prime.r2, prime), prime.mod - 2, prime);
+    runRangeTasks(vals.size(), blockSize, [&](size_t first, size_t last) {
+      for (size_t i = first; i < last; i++) {
+        vals[i] = montgomeryMultiply(vals[i], sizeInv, prime);
+      }
+    });
+  }
+
+  // Limbs are the coefficients of the transformed polynomial
+  std::vector<uint64_t> nttTransform(const IntVector &rhs, size_t size, const NttPrime &prime) {
+    std::vector<uint64_t> vals(size, 0);
+    runRangeTasks(rhs.size(), size / getNttBlocksNum(size), [&](size_t first, size_t last) {
+      for (size_t i = first; i < last; i++) {
+        vals[i] = montgomeryMultiply(rhs[i], prime.r2, prime);
+      }
+    });
+    ntt(vals, prime);
+    return vals;
+  }
+
+  /*
+    Restoring the convolution coefficients from their residues by Garner's algorithm:
+    x = x1 + x2 * p1 + x3 * p1 * p2, where
+    x1 = r1,
+    x2 = (r2 - x1) / p1 mod p2,
+    x3 = ((r3 - x1) / p1 - x2) / p2 mod p3.
+    Then the coefficients are added with carries. The blocks of the coefficients are added independently, the carries
+    out of the blocks are added to the next blocks afterwards.
+  */
+  IntVector nttCombine(std::array<std::vector<uint64_t>, NTT_PRIMES_NUM> &vals, size_t resSize) {
+    const auto &primes = getNttPrimes();
+    const NttPrime &prime1 = primes[0];
+    const NttPrime &prime2 = primes[1];
+    const NttPrime &prime3 = primes[2];
+
+    // Inverses are taken in Montgomery's form, so the multiplication by them gives usual residues
+    uint64_t prime1InvMod2 = montgomeryPow(montgomeryMultiply(prime1.mod % prime2.mod, prime2.r2, prime2),
+                                           prime2.mod - 2, prime2);
+    uint64_t prime1InvMod3 = montgomeryPow(montgomeryMultiply(prime1.mod % prime3.mod, prime3.r2, prime3),
+                                           prime3.mod - 2, prime3);
+    uint64_t prime2InvMod3 = montgomeryPow(montgomeryMultiply(prime2.mod % prime3.mod, prime3.r2, prime3),
+                                           prime3.mod - 2, prime3);
+    uint128_t prime12 = uint128_t(prime1.mod) * prime2.mod;
+
+    size_t blockSize = vals.front().size() / getNttBlocksNum(vals.front().size());
+    IntVector res(resSize + 1, 0);
+    std::vector<uint128_t> carries((resSize + blockSize - 1) / blockSize);
+
+    runRangeTasks(resSize, blockSize, [&](size_t first, size_t last) {
+      uint128_t carryLow = 0;
+      uint64_t carryHigh = 0;
+
+      for (size_t i = first; i < last; i++) {
+        uint64_t x1 = montgomeryReduce(vals[0][i], prime1);
+        uint64_t r2 = montgomeryReduce(vals[1][i], prime2);
+        uint64_t r3 = montgomeryReduce(vals[2][i], prime3);
+
+        uint64_t x1Mod2 = x1 % prime2.mod;
+        uint64_t x2 = montgomeryMultiply(r2 >= x1Mod2 ? r2 - x1Mod2 : r2 + prime2.mod - x1Mod2, prime1InvMod2, prime2);
+
+        uint64_t x1Mod3 = x1 % prime3.mod;
+        uint64_t x2Mod3 = x2 % prime3.mod;
+        uint64_t x3 = montgomeryMultiply(r3 >= x1Mod3 ? r3 - x1Mod3 : r3 + prime3.mod - x1Mod3, prime1InvMod3, prime3);
+        x3 = montgomeryMultiply(x3 >= x2Mod3 ? x3 - x2Mod3 : x3 + prime3.mod - x2Mod3, prime2InvMod3, prime3);
+
+        // Adding x to the 192-bit carry
+        uint128_t low = uint128_t(x3) * uint64_t(prime12);
+        uint128_t high = uint128_t(x3) * uint64_t(prime12 >> INT_BASE_SIZE) + (low >> INT_BASE_SIZE);
+        low = (high << INT_BASE_SIZE) | uint64_t(low);
+        high >>= INT_BASE_SIZE;
+
+        uint128_t sum = uint128_t(x2) * prime1.mod + x1;
+        low += sum;
+        high += low < sum ? 1 : 0;
+
+        carryLow += low;
+        carryHigh += uint64_t(high) + (carryLow < low ? 1 : 0);
+
+        res[i] = uint64_t(carryLow);
+        carryLow = (carryLow >> INT_BASE_SIZE) | (uint128_t(carryHigh) << INT_BASE_SIZE);
+        carryHigh = 0;
+      }
+
+      carries[first / blockSize] = carryLow;
+    });
+
+    for (size_t i = 0; i < carries.size(); i++) {
+      IntVector carry{uint64_t(carries[i]), uint64_t(carries[i] >> INT_BASE_SIZE)};
+      addShifted(res, carry, std::min((i + 1) * blockSize, resSize));
+    }
+
+    toSignificantDigits(res);
+    return res;
+  }
+
+  /*
+    Multiplication of numbers A by B by the number-theoretic transform. Limbs are considered as coefficients of
+    polynomials, which are multiplied modulo three primes by transforms of size 2^k >= A.size() + B.size(). The
+    coefficients of the product are restored by the Chinese remainder theorem.
+
+    Transforms of B are cached, so multiplication of different numbers by the same B transforms it only once.
+  */
+  IntVector nttMultiply(const IntVector &lhs, const IntVector &rhs) {
+    static thread_local NttCache cache;
+
+    size_t resSize = lhs.size() + rhs.size();
+    size_t size = 1;
+    while (size < resSize) {
+      size *= 2;
+    }
+
+    bool isLhsCached = cache.size == size && equal(cache.intVect, lhs);
+    bool isRhsCached = cache.size == size && equal(cache.intVect, rhs);
+
+    std::array<std::vector<uint64_t>, NTT_PRIMES_NUM> vals;
+    std::array<std::vector<uint64_t>, NTT_PRIMES_NUM> rhsVals;
+
+    // The cache is thread local, so the tasks use it through a reference to the cache of the calling thread
+    const NttCache &callerCache = cache;
+
+    std::vector<std::function<void()>> tasks;
+    for (size_t i = 0; i < NTT_PRIMES_NUM; i++) {
+      tasks.emplace_back([&, i] {
+        const NttPrime &prime = getNttPrimes()[i];
+
+        vals[i] = isLhsCached ? callerCache.transforms[i] : nttTransform(lhs, size, prime);
+        if (!isRhsCached) {
+          rhsVals[i] = nttTransform(rhs, size, prime);
+        }
+        const std::vector<uint64_t> &rhsTransform = isRhsCached ? callerCache.transforms[i] : rhsVals[i];
+
+        runRangeTasks(size, size / getNttBlocksNum(size), [&](size_t first, size_t last) {
+          for (size_t j = first; j < last; j++) {
+            vals[i][j] = montgomeryMultiply(vals[i][j], rhsTransform[j], prime);
+          }
+        });
+        inverseNtt(vals[i], prime);
+      });
+    }
+    runTasks(tasks, std::max(lhs.size(), rhs.size()));
+
+    if (!isRhsCached && !isLhsCached) {
+      cache.intVect = rhs;
+      cache.size = size;
+      cache.transforms = std::move(rhsVals);
+    }
+
+    return nttCombine(vals, resSize);
+  }
+
+  // Squaring by the number-theoretic transform, the number is transformed only once
+  IntVector nttSquare(const IntVector &rhs) {
+    size_t resSize = rhs.size() * 2;
+    size_t size = 1;
+    while (size < resSize) {
+      size *= 2;
+    }
+
+    std::array<std::vector<uint64_t>, NTT_PRIMES_NUM> vals;
+
+    std::vector<std::function<void()>> tasks;
+    for (size_t i = 0; i < NTT_PRIMES_NUM; i++) {
+      tasks.emplace_back([&, i] {
+        const NttPrime &prime = getNttPrimes()[i];
+
+        vals[i] = nttTransform(rhs, size, prime);
+        runRangeTasks(size, size / getNttBlocksNum(size), [&](size_t first, size_t last) {
+          for (size_t j = first; j < last; j++) {
+            vals[i][j] = montgomeryMultiply(vals[i][j], vals[i][j], prime);
+          }
+        });
+        inverseNtt(vals[i], prime);
+      });
+    }
+    runTasks(tasks, rhs.size());
+
+    return nttCombine(vals, resSize);
+  }
+
+  // Dividing by a short number
+  IntVector shortDivide(const IntVector &lhs, uint64_t rhs) {
+    IntVector modVal;
+    return shortDivide(lhs, rhs, modVal);
+  }
+
+  // Dividing by short number with a remainder
+  IntVector shortDivide(const IntVector &lhs, uint64_t rhs, IntVector &modVal) {
+    IntVector val = lhs;
+
+    uint64_t rem = 0;
+    for (size_t i = val.size() - 1; i != SIZE_MAX; i--) {
+      uint128_t cur = (uint128_t(rem) << INT_BASE_SIZE) | val[i];
+      val[i] = uint64_t(cur / rhs);
+      rem = uint64_t(cur % rhs);
+    }
+    modVal = IntVector{rem};
+
     toSignificantDigits(val);
     return val;
   }
 
   /*
-    Multiplication of numbers in the form of polynomials without reduction to significant digits
+    Knuth's Algorithm D (The Art of Computer Programming, vol. 2, 4.3.1).
+
+    1. Normalize: shift A and B left so that the highest bit of B is set. A gets one extra high limb.
+
+    2. For each quotient limb from the highest one estimate q = (A[j + n] * BASE + A[j + n - 1]) / B[n - 1] and correct
+    it using B[n - 2]. After the correction q exceeds the true quotient limb by at most one.
+
+    3. Subtract q * B from the current window of A. If the result is negative, decrease q and add B back.
+
+    4. The remaining low n limbs of A shifted back right are the remainder.
   */
-  IntVector polynomialMultiply(const IntVector &lhs, const IntVector &rhs, int64_t base) {
-    IntVector res;
-    res.resize(lhs.size() + rhs.size(), 0);
+  IntVector knuthDivide(const IntVector &lhs, const IntVector &rhs, IntVector &modVal) {
+    auto shift = uint64_t(__builtin_clzll(rhs.back()));
+    size_t n = rhs.size();
+    size_t m = lhs.size() - n;
+
+    IntVector rem = shiftLeft(lhs, shift);
+    rem.resize(lhs.size() + 1);
+    IntVector div = shiftLeft(rhs, shift);
+
+    uint64_t divHigh = div[n - 1];
+    uint64_t divNext = div[n - 2];
+
+    IntVector val(m + 1, 0);
+
+    for (size_t j = m; j != SIZE_MAX; j--) {
+      uint128_t cur = (uint128_t(rem[j + n]) << INT_BASE_SIZE) | rem[j + n - 1];
+      uint128_t q = cur / divHigh;
+      uint128_t r = cur % divHigh;
+
+      while (q > UINT64_MAX || q * divNext > ((r << INT_BASE_SIZE) | rem[j + n - 2])) {
+        q--;
+        r += divHigh;
+        if (r > UINT64_MAX) {
+          break;
+        }
+      }
 
-    for (size_t i = 0; i < lhs.size(); i++) {
-      for (size_t j = 0; j < rhs.size(); j++) {
-        res[i + j] += lhs[i] * rhs[j];
-        toBasePositive(res, i + j, base);
+      uint64_t carry = 0;
+      uint64_t borrow = 0;
+      for (size_t i = 0; i < n; i++) {
+        uint128_t prod = q * div[i] + carry;
+        carry = uint64_t(prod >> INT_BASE_SIZE);
+        auto prodLow = uint64_t(prod);
+        uint64_t diff = rem[i + j] - prodLow;
+        uint64_t newBorrow = rem[i + j] < prodLow;
+        newBorrow += diff < borrow;
+        rem[i + j] = diff - borrow;
+        borrow = newBorrow;
+      }
+      uint64_t high = rem[j + n];
+      rem[j + n] = high - carry - borrow;
+
+      if (high < uint128_t(carry) + borrow) {
+        q--;
+        uint64_t addCarry = 0;
+        for (size_t i = 0; i < n; i++) {
+          uint128_t sum = uint128_t(rem[i + j]) + div[i] + addCarry;
+          rem[i + j] = uint64_t(sum);
+          addCarry = uint64_t(sum >> INT_BASE_SIZE);
+        }
+        rem[j + n] += addCarry;
       }
+
+      val[j] = uint64_t(q);
     }
 
-    return res;
+    rem.resize(n);
+    toSignificantDigits(rem);
+    modVal = shiftRight(rem, shift);
+
+    toSignificantDigits(val);
+    return val;
+  }
+
+  // Number made of limbsNum limbs of rhs starting from the first one
+  IntVector getLimbs(const IntVector &rhs, size_t first, size_t limbsNum) {
+    if (first >= rhs.size()) {
+      return IntVector{0};
+    }
+
+    IntVector val(rhs.begin() + first, rhs.begin() + std::min(first + limbsNum, rhs.size()));
+    toSignificantDigits(val);
+    return val;
   }
 
   /*
-    Multiplication of numbers A by B by Karatsuba's method. Recursively applied until the size of of one of the
-    numbers is equal to KARATSUBA_CUTOFF
+    Recursive division of A by normalized B of n digits (Burnikel and Ziegler), where A < B * BASE^m and m <= n.
 
-    A * B = p0 + p1 * INT_BASE^m + p2 * INT_BASE^2m
+    1. Split B = B1 * BASE^k + B0 with k = m / 2 and divide the high part A / BASE^(2k) by B1 recursively. This gives
+    the estimate Q1 of the high half of the quotient and the remainder R1.
 
-    p0 = A0 * B0
-    p1 = (A0 + A1)(B0 + B1) - (p1 + p2)
-    p2 = A1 * B1
+    2. Calculate A1 = R1 * BASE^k + (k digits of A after the high part) - Q1 * B0. While A1 is negative, decrease Q1
+    and add B to A1. The estimate is too big by at most two.
 
-    A0 and B0 - the first halves of numbers
-    A1 and B1 - the second halves of numbers
+    3. Repeat the same for A1 and the low k digits of A to find the low half Q0 of the quotient and the remainder.
+
+    The recursive calls are balanced, so the division costs O(M(n) * log(n)) where M(n) is the cost of multiplication.
   */
-  IntVector karatsubaMultiply(const IntVector &lhs, const IntVector &rhs, int64_t base) {
-    if (lhs.size() < KARATSUBA_CUTOFF) {
-      return polynomialMultiply(lhs, rhs, base);
+  IntVector recursiveDivide(const IntVector &lhs, const IntVector &rhs, IntVector &modVal) {
+    if (greater(rhs, lhs)) {
+      modVal = lhs;
+      return IntVector{0};
+    }
+
+    size_t m = lhs.size() - rhs.size();
+    if (!greater(rhs, shiftRight(lhs, m * INT_BASE_SIZE))) {
+      m++;
+    }
+    if (m < BURNIKEL_ZIEGLER_CUTOFF) {
+      return knuthDivide(lhs, rhs, modVal);
     }
 
-    auto mid = int64_t(lhs.size() / 2);
+    size_t k = m / 2;
+    IntVector rhsHigh = shiftRight(rhs, k * INT_BASE_SIZE);
+    IntVector rhsLow = getLimbs(rhs, 0, k);
 
-    IntVector lhsHalf1(lhs.begin(), lhs.begin() + mid);
-    IntVector lhsHalf2(lhs.begin() + mid, lhs.end());
+    IntVector highMod;
+    IntVector highVal = recursiveDivide(shiftRight(lhs, 2 * k * INT_BASE_SIZE), rhsHigh, highMod);
 
-    IntVector rhsHalf1(rhs.begin(), rhs.begin() + mid);
-    IntVector rhsHalf2(rhs.begin() + mid, rhs.end());
+    IntVector highRem = getLimbs(lhs, k, k);
+    addShifted(highRem, highMod, k);
+    toSignificantDigits(highRem);
 
-    IntVector coeff1 = karatsubaMultiply(lhsHalf1, rhsHalf1, base);
-    IntVector coeff2 = karatsubaMultiply(add(lhsHalf1, lhsHalf2, base), add(rhsHalf1, rhsHalf2, base), base);
-    IntVector coeff3 = karatsubaMultiply(lhsHalf2, rhsHalf2, base);
+    IntVector prod = multiply(highVal, rhsLow);
+    while (greater(prod, highRem)) {
+      highVal = substract(highVal, IntVector{1});
+      highRem = addToSignificantDigits(highRem, rhs);
+    }
+    highRem = substract(highRem, prod);
+
+    IntVector lowMod;
+    IntVector lowVal = recursiveDivide(highRem, rhsHigh, lowMod);
 
-    coeff2 = substract(coeff2, add(coeff3, coeff1, base), base);
+    IntVector lowRem = getLimbs(lhs, 0, k);
+    addShifted(lowRem, lowMod, k);
+    toSignificantDigits(lowRem);
 
-    coeff2.insert(coeff2.begin(), size_t(mid), 0);
-    coeff3.insert(coeff3.begin(), size_t(mid) * 2, 0);
+    prod = multiply(lowVal, rhsLow);
+    while (greater(prod, lowRem)) {
+      lowVal = substract(lowVal, IntVector{1});
+      lowRem = addToSignificantDigits(lowRem, rhs);
+    }
+    modVal = substract(lowRem, prod);
 
-    return add(add(coeff3, coeff2, base), coeff1, base);
+    addShifted(lowVal, highVal, k);
+    toSignificantDigits(lowVal);
+    return lowVal;
   }
 
-  // Multiplication of zero digits
-  int64_t zerosMultiply(IntVector &lhs, IntVector &rhs) {
-    int64_t lhsZerosNum = firstZeroNum(lhs);
-    int64_t rhsZerosNum = firstZeroNum(rhs);
+  /*
+    Division of A by B for large numbers.
 
-    if (lhs.size() != 1) {
-      lhs.erase(lhs.begin(), lhs.begin() + lhsZerosNum);
-    }
-    if (rhs.size() != 1) {
-      rhs.erase(rhs.begin(), rhs.begin() + rhsZerosNum);
+    B is normalized so that its highest bit is set, then A is divided in blocks of n = B.size() digits starting from
+    the highest one. Each step divides the previous remainder followed by the next block by B, so that every recursive
+    division has a quotient of at most n digits.
+  */
+  IntVector burnikelZieglerDivide(const IntVector &lhs, const IntVector &rhs, IntVector &modVal) {
+    auto shift = uint64_t(__builtin_clzll(rhs.back()));
+    IntVector tmpLhs = shiftLeft(lhs, shift);
+    IntVector tmpRhs = shiftLeft(rhs, shift);
+
+    size_t n = tmpRhs.size();
+    size_t blocksNum = tmpLhs.size() / n + 1;
+
+    IntVector val(blocksNum * n, 0);
+    IntVector rem{0};
+
+    for (size_t i = blocksNum - 1; i != SIZE_MAX; i--) {
+      IntVector cur = getLimbs(tmpLhs, i * n, n);
+      addShifted(cur, rem, n);
+      toSignificantDigits(cur);
+
+      IntVector blockVal = recursiveDivide(cur, tmpRhs, rem);
+      std::copy(blockVal.begin(), blockVal.end(), val.begin() + i * n);
     }
 
-    return lhsZerosNum + rhsZerosNum;
+    modVal = shiftRight(rem, shift);
+
+    toSignificantDigits(val);
+    return val;
   }
 
-  // Adding leading zeros to bring the numbers to the required form
-  IntVector multiply(const IntVector &lhs, const IntVector &rhs, int64_t base) {
-    IntVector tmpLhs = lhs;
-    IntVector tmpRhs = rhs;
-    IntVector res;
-    int64_t zerosNum = zerosMultiply(tmpLhs, tmpRhs);
+  // Dividing lhs by rhs with a remainder
+  IntVector divide(const IntVector &lhs, const IntVector &rhs, IntVector &modVal) {
+    if (rhs.size() == 1) {
+      return shortDivide(lhs, rhs.front(), modVal);
+    }
+    if (greater(rhs, lhs)) {
+      modVal = lhs;
+      return IntVector{0};
+    }
+    if (rhs.size() >= BURNIKEL_ZIEGLER_CUTOFF && lhs.size() - rhs.size() >= BURNIKEL_ZIEGLER_CUTOFF) {
+      return burnikelZieglerDivide(lhs, rhs, modVal);
+    }
+    return knuthDivide(lhs, rhs, modVal);
+  }
 
-    if (tmpRhs.size() < KARATSUBA_CUTOFF) {
-      res = polynomialMultiply(tmpLhs, tmpRhs, base);
-    } else {
-      size_t maxSize = std::max(tmpLhs.size(), tmpRhs.size());
-      if (maxSize % 2 == 1) {
-        maxSize++;
-      }
-      tmpLhs.resize(maxSize, 0);
-      tmpRhs.resize(maxSize, 0);
+  /*
+    Exact division by Jebelean's method, A must be divisible by B. The common powers of two are removed, then the
+    quotient limbs are found from the lowest one: q = A[i] * B[0]^-1 mod 2^64 and q * B is substracted from A. The
+    quotient size is known in advance, so the limbs of A above it are never updated and no corrections are needed.
+    Long numbers are divided by the subquadratic method instead.
+  */
+  IntVector exactDivide(const IntVector &lhs, const IntVector &rhs) {
+    size_t zerosNum = firstZeroNum(rhs);
+    uint64_t bitsNum = zerosNum * INT_BASE_SIZE + uint64_t(__builtin_ctzll(rhs[zerosNum]));
+    IntVector tmpLhs = bitsNum != 0 ? shiftRight(lhs, bitsNum) : lhs;
+    IntVector tmpRhs = bitsNum != 0 ? shiftRight(rhs, bitsNum) : rhs;
+
+    if (tmpRhs.size() == 1 && tmpRhs.front() == 1) {
+      return tmpLhs;
+    }
+    if (less(tmpLhs, tmpRhs)) {
+      return IntVector{0};
+    }
 
-      res = karatsubaMultiply(tmpLhs, tmpRhs, base);
+    size_t resSize = tmpLhs.size() - tmpRhs.size() + 1;
+    if (tmpRhs.size() >= EXACT_DIVIDE_CUTOFF && resSize >= EXACT_DIVIDE_CUTOFF) {
+      IntVector modVal;
+      return burnikelZieglerDivide(tmpLhs, tmpRhs, modVal);
+    }
+
+    uint64_t inv = inverseLimb(tmpRhs.front());
+    IntVector res(resSize, 0);
+    tmpLhs.resize(resSize);
+
+    for (size_t i = 0; i < resSize; i++) {
+      uint64_t quotient = tmpLhs[i] * inv;
+      res[i] = quotient;
+
+      size_t last = std::min(resSize, i + tmpRhs.size());
+      uint64_t carry = 0;
+      for (size_t j = i; j < last; j++) {
+        uint128_t prod = uint128_t(quotient) * tmpRhs[j - i] + carry;
+        auto low = uint64_t(prod);
+        carry = uint64_t(prod >> INT_BASE_SIZE) + (tmpLhs[j] < low ? 1 : 0);
+        tmpLhs[j] -= low;
+      }
+      for (size_t j = last; j < resSize && carry != 0; j++) {
+        uint64_t limb = tmpLhs[j];
+        tmpLhs[j] = limb - carry;
+        carry = limb < carry ? 1 : 0;
+      }
     }
 
-    res.insert(res.begin(), size_t(zerosNum), 0);
     toSignificantDigits(res);
     return res;
   }
 
-  // Dividing by a short number
-  IntVector shortDivide(const IntVector &lhs, int64_t rhs, int64_t base) {
-    IntVector val = lhs;
+  // Square root of a two-limb number. The estimate in double precision is refined by Newton's iterations from above
+  uint64_t shortSqrt(uint128_t rhs) {
+    auto val = uint128_t(std::sqrt(double(rhs))) + (uint128_t(1) << (INT_BASE_SIZE / 4));
+    for (uint128_t next = (val + rhs / val) / 2; next < val; next = (val + rhs / val) / 2) {
+      val = next;
+    }
+    return uint64_t(val);
+  }
+
+  /*
+    Square root of A with the remainder by Zimmermann's method (Karatsuba square root). A has 2n digits and its
+    highest digit has one of the two highest bits set.
+
+    1. Split A = A1 * BASE^(2l) + a1 * BASE^l + a0, where l = n / 2 and a1, a0 have l digits each.
 
-    for (size_t i = val.size() - 1; i > 0; i--) {
-      val[i - 1] += (val[i] % rhs) * base;
-      val[i] /= rhs;
+    2. Calculate S1 = sqrt(A1) with the remainder R1 recursively.
+
+    3. Divide R1 * BASE^l + a1 by 2 * S1, giving Q with the remainder U.
+
+    4. S = S1 * BASE^l + Q and R = U * BASE^l + a0 - Q^2. If R is negative, R = R + 2 * S - 1 and S = S - 1.
+
+    The cost is about the cost of one division of numbers of n digits.
+  */
+  IntVector karatsubaSqrt(const IntVector &rhs, size_t limbsNum, IntVector &remVal) {
+    if (limbsNum == 1) {
+      uint128_t num = rhs.size() == 1 ? rhs.front() : (uint128_t(rhs[1]) << INT_BASE_SIZE) | rhs[0];
+      uint64_t root = shortSqrt(num);
+      uint128_t rem = num - uint128_t(root) * root;
+      remVal = IntVector{uint64_t(rem), uint64_t(rem >> INT_BASE_SIZE)};
+      toSignificantDigits(remVal);
+      return IntVector{root};
     }
-    val.front() /= rhs;
 
+    size_t lowSize = limbsNum / 2;
+    size_t highSize = limbsNum - lowSize;
+
+    IntVector highRem;
+    IntVector highVal = karatsubaSqrt(getLimbs(rhs, 2 * lowSize, 2 * highSize), highSize, highRem);
+
+    IntVector num = getLimbs(rhs, lowSize, lowSize);
+    addShifted(num, highRem, lowSize);
+    toSignificantDigits(num);
+
+    IntVector quotientRem;
+    IntVector val = divide(num, shiftLeft(highVal, 1), quotientRem);
+    IntVector quotientSqr = multiply(val, val);
+
+    addShifted(val, highVal, lowSize);
     toSignificantDigits(val);
+
+    remVal = getLimbs(rhs, 0, lowSize);
+    addShifted(remVal, quotientRem, lowSize);
+    toSignificantDigits(remVal);
+
+    if (greater(quotientSqr, remVal)) {
+      remVal = substract(addToSignificantDigits(remVal, shiftLeft(val, 1)), IntVector{1});
+      val = substract(val, IntVector{1});
+    }
+    remVal = substract(remVal, quotientSqr);
+
     return val;
   }
 
-  // Dividing by short number with a remainder
-  IntVector shortDivide(const IntVector &lhs, int64_t rhs, IntVector &modVal, int64_t base) {
-    IntVector val = lhs;
+  /*
+    A is shifted left by an even number of bits so that its highest digit has one of the two highest bits set and the
+    number of digits is even. The square root of the shifted number is then shifted right by half of the bits.
+  */
+  IntVector sqrt(const IntVector &rhs) {
+    if (rhs.size() == 1 && rhs.front() == 0) {
+      return IntVector{0};
+    }
 
-    for (size_t i = val.size() - 1; i > 0; i--) {
-      val[i - 1] += (val[i] % rhs) * base;
-      val[i] /= rhs;
+    auto bitsShift = uint64_t(__builtin_clzll(rhs.back())) & ~uint64_t(1);
+    IntVector tmpRhs = shiftLeft(rhs, bitsShift);
+    if (tmpRhs.size() % 2 == 1) {
+      tmpRhs.insert(tmpRhs.begin(), 1, 0);
+      bitsShift += INT_BASE_SIZE;
     }
-    modVal = IntVector{val.front() % rhs};
-    val.front() /= rhs;
 
-    toSignificantDigits(val);
+    IntVector remVal;
+    IntVector val = karatsubaSqrt(tmpRhs, tmpRhs.size() / 2, remVal);
+    return shiftRight(val, bitsShift / 2);
+  }
+
+  // Square root with the remainder
+  IntVector sqrt(const IntVector &rhs, IntVector &remVal) {
+    IntVector val = sqrt(rhs);
+    remVal = substract(rhs, multiply(val, val));
     return val;
   }
 
-  // Reduction of zero digits of numbers
-  void zerosDivide(IntVector &lhs, IntVector &rhs) {
-    int64_t zerosNum = std::min(firstZeroNum(lhs), firstZeroNum(rhs));
-    if (zerosNum != 0) {
-      lhs.erase(lhs.begin(), lhs.begin() + zerosNum);
-      rhs.erase(rhs.begin(), rhs.begin() + zerosNum);
+  // Binary GCD by Stein's method, the common powers of two are taken out and the odd numbers are substracted
+  uint64_t binaryGcd(uint64_t lhs, uint64_t rhs) {
+    if (lhs == 0 || rhs == 0) {
+      return lhs | rhs;
+    }
+
+    int shift = __builtin_ctzll(lhs | rhs);
+    lhs >>= __builtin_ctzll(lhs);
+    while (rhs != 0) {
+      rhs >>= __builtin_ctzll(rhs);
+      if (lhs > rhs) {
+        std::swap(lhs, rhs);
+      }
+      rhs -= lhs;
     }
+
+    return lhs << shift;
   }
 
-  IntVector binsearchDivide(const IntVector &lhs, const IntVector &rhs, IntVector &left, IntVector &right,
-                            int64_t base) {
-    IntVector mid;
-    while (greater(substract(right, left, base), IntVector{1})) {
-      mid = shortDivide(addToSignificantDigits(left, right, base), 2, base);
-      IntVector multVal = multiply(rhs, mid, base);
-      if (greater(multVal, lhs)) {
-        right = mid;
-      } else {
-        left = mid;
+  // Binary GCD of two-limb numbers, it continues with single limbs as soon as the numbers fit into them
+  uint128_t binaryGcd(uint128_t lhs, uint128_t rhs) {
+    if (lhs == 0 || rhs == 0) {
+      return lhs | rhs;
+    }
+
+    auto trailingZerosNum = [](uint128_t val) {
+      return uint64_t(val) != 0 ? uint64_t(__builtin_ctzll(uint64_t(val)))
+                                : INT_BASE_SIZE + uint64_t(__builtin_ctzll(uint64_t(val >> INT_BASE_SIZE)));
+    };
+
+    uint64_t shift = trailingZerosNum(lhs | rhs);
+    lhs >>= trailingZerosNum(lhs);
+    while (rhs != 0) {
+      if ((lhs >> INT_BASE_SIZE) == 0 && (rhs >> INT_BASE_SIZE) == 0) {
+        return uint128_t(binaryGcd(uint64_t(lhs), uint64_t(rhs))) << shift;
+      }
+
+      rhs >>= trailingZerosNum(rhs);
+      if (lhs > rhs) {
+        std::swap(lhs, rhs);
       }
+      rhs -= lhs;
+    }
+
+    return lhs << shift;
+  }
+
+  // 64 bits of the number starting with the bit first
+  uint64_t getBits(const IntVector &rhs, size_t first) {
+    size_t limb = first / INT_BASE_SIZE;
+    size_t shift = first % INT_BASE_SIZE;
+
+    if (limb >= rhs.size()) {
+      return 0;
     }
 
-    if (IntVector mult = multiply(rhs, right, base); greater(lhs, mult) || equal(lhs, mult)) {
-      return right;
+    uint64_t val = rhs[limb] >> shift;
+    if (shift != 0 && limb + 1 < rhs.size()) {
+      val |= rhs[limb + 1] << (INT_BASE_SIZE - shift);
     }
-    return left;
+    return val;
   }
 
   /*
-    The lower and upper bounds for binsearch division are defined as follows: N = A/(B.back() +- 1). N is the
-    corresponding bound of B.back() - the most significant digit of B. Then (N.size() + B.size()) of the first digits
-    are discarded.
+    Lehmer's step of GCD of A >= B (Knuth, The Art of Computer Programming, vol. 2, 4.5.2, Algorithm L). Euclid's
+    quotients are found on the leading 62 bits of A and the same bits of B, while the bounds computed with the
+    cofactors show they are the true quotients of A and B. All the steps are applied to A and B at once by the
+    cofactors: A' = c0 * A + c1 * B, B' = c2 * A + c3 * B. Returns false if not a single quotient is found and a full
+    division step is needed.
   */
-  IntVector divide(const IntVector &lhs, const IntVector &rhs, IntVector &modVal, int64_t base) {
-    if (rhs.size() == 1) {
-      return shortDivide(lhs, rhs.front(), modVal, base);
+  bool lehmerCofactors(const IntVector &lhs, const IntVector &rhs, std::array<int64_t, 4> &cofactors) {
+    size_t shift = (lhs.size() - 1) * INT_BASE_SIZE + INT_BASE_SIZE - uint64_t(__builtin_clzll(lhs.back())) -
+                   LEHMER_BITS_NUM;
+    auto lhsHigh = int64_t(getBits(lhs, shift));
+    auto rhsHigh = int64_t(getBits(rhs, shift));
+
+    // All the values are less than 2^62 by absolute value, the products can overflow only in the middle of calculations
+    auto mulSub = [](int64_t lhsVal, int64_t quotient, int64_t rhsVal) {
+      return int64_t(uint64_t(lhsVal) - uint64_t(quotient) * uint64_t(rhsVal));
+    };
+
+    int64_t c0 = 1;
+    int64_t c1 = 0;
+    int64_t c2 = 0;
+    int64_t c3 = 1;
+
+    while (rhsHigh + c2 != 0 && rhsHigh + c3 != 0) {
+      int64_t quotient = (lhsHigh + c0) / (rhsHigh + c2);
+      if (quotient != (lhsHigh + c1) / (rhsHigh + c3)) {
+        break;
+      }
+
+      int64_t val = mulSub(c0, quotient, c2);
+      c0 = c2;
+      c2 = val;
+      val = mulSub(c1, quotient, c3);
+      c1 = c3;
+      c3 = val;
+      val = mulSub(lhsHigh, quotient, rhsHigh);
+      lhsHigh = rhsHigh;
+      rhsHigh = val;
     }
 
-    IntVector tmpLhs = lhs;
-    IntVector tmpRhs = rhs;
-    zerosDivide(tmpLhs, tmpRhs);
+    cofactors = {c0, c1, c2, c3};
+    return c1 != 0;
+  }
 
-    IntVector left;
-    IntVector right;
-    left = shortDivide(tmpLhs, tmpRhs.back() + 1, base);
+  // Linear combination lhsCoeff * lhs + rhsCoeff * rhs, it must be non-negative and not greater than lhs
+  IntVector linearCombination(const IntVector &lhs, int64_t lhsCoeff, const IntVector &rhs, int64_t rhsCoeff) {
+    IntVector res(lhs.size(), 0);
 
-    if (tmpRhs.back() != 1) {
-      right = shortDivide(tmpLhs, tmpRhs.back() - 1, base);
-    } else {
-      right = tmpLhs;
-      right.back() = INT_BASE - 1;
+    int128_t carry = 0;
+    for (size_t i = 0; i < lhs.size(); i++) {
+      int128_t val = carry + int128_t(lhsCoeff) * lhs[i];
+      if (i < rhs.size()) {
+        val += int128_t(rhsCoeff) * rhs[i];
+      }
+      res[i] = uint64_t(val);
+      carry = val >> INT_BASE_SIZE;
     }
 
-    left.erase(left.begin(), left.begin() + int64_t(tmpRhs.size()) - 1);
-    right.erase(right.begin(), right.begin() + int64_t(tmpRhs.size()) - 1);
+    toSignificantDigits(res);
+    return res;
+  }
 
-    if (equal(right, left)) {
-      modVal = substract(lhs, multiply(rhs, left, base), base);
-      return left;
+  GcdMatrix multiply(const GcdMatrix &lhs, const GcdMatrix &rhs) {
+    auto multiplySigned = [](const SignedIntVector &lhsVal, const SignedIntVector &rhsVal) {
+      SignedIntVector res{multiply(lhsVal.intVect, rhsVal.intVect), lhsVal.sign != rhsVal.sign};
+      if (res.intVect.size() == 1 && res.intVect.front() == 0) {
+        res.sign = false;
+      }
+      return res;
+    };
+
+    GcdMatrix res;
+    for (size_t i = 0; i < 2; i++) {
+      for (size_t j = 0; j < 2; j++) {
+        res.vals[i * 2 + j] = signedAdd(multiplySigned(lhs.vals[i * 2], rhs.vals[j]),
+                                        multiplySigned(lhs.vals[i * 2 + 1], rhs.vals[2 + j]));
+      }
     }
-
-    IntVector val = binsearchDivide(tmpLhs, tmpRhs, left, right, base);
-    modVal = substract(lhs, multiply(rhs, val, base), base);
-    return val;
+    return res;
   }
 
   /*
-    Calculating the square root of A in a column.
+    Reducing A >= B by Lehmer's step, or by Euclid's step if Lehmer's one is impossible. The matrix, if it is given, is
+    multiplied by the matrix of the step.
+  */
+  void gcdStep(IntVector &lhs, IntVector &rhs, GcdMatrix *matrix) {
+    std::array<int64_t, 4> cofactors{};
+
+    if (rhs.size() > 2 && lehmerCofactors(lhs, rhs, cofactors)) {
+      IntVector val = linearCombination(lhs, cofactors[0], rhs, cofactors[1]);
+      rhs = linearCombination(lhs, cofactors[2], rhs, cofactors[3]);
+      lhs = std::move(val);
+
+      if (matrix) {
+        std::array<SignedIntVector, 4> &vals = matrix->vals;
+        for (size_t j = 0; j < 2; j++) {
+          SignedIntVector val0 =
+              signedAdd(signedShortMultiply(vals[j], cofactors[0]), signedShortMultiply(vals[2 + j], cofactors[1]));
+          vals[2 + j] =
+              signedAdd(signedShortMultiply(vals[j], cofactors[2]), signedShortMultiply(vals[2 + j], cofactors[3]));
+          vals[j] = std::move(val0);
+        }
+      }
+      return;
+    }
+
+    IntVector modVal;
+    IntVector quotient = divide(lhs, rhs, modVal);
+    lhs = std::move(rhs);
+    rhs = std::move(modVal);
+
+    if (matrix) {
+      std::array<SignedIntVector, 4> &vals = matrix->vals;
+      for (size_t j = 0; j < 2; j++) {
+        SignedIntVector val1 =
+            signedSubstract(vals[j], SignedIntVector{multiply(quotient, vals[2 + j].intVect), vals[2 + j].sign});
+        vals[j] = std::move(vals[2 + j]);
+        vals[2 + j] = std::move(val1);
+      }
+    }
+  }
 
-    1. Divide number A into faces, two digits in each face from right to left (from lowest to highest digits).
+  /*
+    Reducing A and B by the matrix of the steps found for their leading parts. If the steps do not fit A and B
+    exactly, the values can become negative or misordered, then the rows of the step are negated or swapped. The
+    matrix stays unimodular, so the GCD is kept in any case.
+  */
+  void applyGcdMatrix(GcdMatrix step, IntVector &lhs, IntVector &rhs, GcdMatrix *matrix) {
+    std::array<SignedIntVector, 4> &vals = step.vals;
+    std::array<SignedIntVector, 2> res;
+
+    for (size_t i = 0; i < 2; i++) {
+      res[i] = signedAdd(SignedIntVector{multiply(vals[i * 2].intVect, lhs), vals[i * 2].sign},
+                         SignedIntVector{multiply(vals[i * 2 + 1].intVect, rhs), vals[i * 2 + 1].sign});
+      if (res[i].sign) {
+        res[i].sign = false;
+        vals[i * 2].sign = !vals[i * 2].sign && !(vals[i * 2].intVect.size() == 1 && vals[i * 2].intVect[0] == 0);
+        vals[i * 2 + 1].sign =
+            !vals[i * 2 + 1].sign && !(vals[i * 2 + 1].intVect.size() == 1 && vals[i * 2 + 1].intVect[0] == 0);
+      }
+    }
 
-    Extraction starts from left to right. Choose a number, the square of which does not exceed the number in the first
-    facet. This number is squared and written under the number in the first face. 3.
+    if (less(res[0].intVect, res[1].intVect)) {
+      std::swap(res[0], res[1]);
+      std::swap(vals[0], vals[2]);
+      std::swap(vals[1], vals[3]);
+    }
 
-    Find the difference between the number in the first face and the square of the first selected number.
+    lhs = std::move(res[0].intVect);
+    rhs = std::move(res[1].intVect);
 
-    4. To the resulting difference, add the next face, and the resulting number will be divisible. Form the divisor.
-    The first answer choice should be multiplied by 2, we get the number of tens of the divisor, and the number of
-    units should be such that its product of the whole divisor does not exceed the divisor. Write the selected digit
-    in the answer. Use binary search for selection.
+    if (matrix) {
+      *matrix = multiply(step, *matrix);
+    }
+  }
 
-    5.To the resulting difference carry the next facet and follow the algorithm.
+  /*
+    Half-GCD of A >= B of n digits, which reduces B to at most s = n / 2 + 1 digits with O(M(n) log n) operations
+    (Thull and Yap, Möller). The steps for the highest n / 2 digits of A and B are found recursively and applied to the
+    whole numbers, which leaves about 3n / 4 digits. After one more step the steps for the leading 2 (m - s) digits of
+    the m-digit numbers are found and applied the same way. Short numbers and the final steps are done by Lehmer's
+    method.
   */
-  IntVector sqrt(const IntVector &rhs) {
-    const int64_t base = 10;
+  void halfGcd(IntVector &lhs, IntVector &rhs, GcdMatrix *matrix) {
+    size_t size = lhs.size() / 2 + 1;
+    if (rhs.size() <= size) {
+      return;
+    }
+
+    if (lhs.size() >= HALF_GCD_CUTOFF) {
+      size_t first = lhs.size() / 2;
+      IntVector lhsHigh(lhs.begin() + first, lhs.end());
+      IntVector rhsHigh(rhs.begin() + first, rhs.end());
+      GcdMatrix step;
+      halfGcd(lhsHigh, rhsHigh, &step);
+      applyGcdMatrix(std::move(step), lhs, rhs, matrix);
+
+      if (rhs.size() > size) {
+        gcdStep(lhs, rhs, matrix);
+      }
+
+      if (rhs.size() > size && size * 2 > lhs.size()) {
+        first = size * 2 - lhs.size();
+        lhsHigh = IntVector(lhs.begin() + first, lhs.end());
+        rhsHigh = rhs.size() > first ? IntVector(rhs.begin() + first, rhs.end()) : IntVector{0};
+        step = GcdMatrix();
+        halfGcd(lhsHigh, rhsHigh, &step);
+        applyGcdMatrix(std::move(step), lhs, rhs, matrix);
+      }
+    }
 
-    IntVector val{int64_t(std::sqrt(double(rhs.back())))};
-    IntVector diff;
+    while (rhs.size() > size) {
+      gcdStep(lhs, rhs, matrix);
+    }
+  }
 
-    getSqrtDiff(rhs, base, val, diff);
+  /*
+    GCD by the half-GCD method for long numbers of close sizes and by Lehmer's method while the numbers are longer
+    than two limbs, each Lehmer's step removes about 30 bits from them with a single pass of multiplying by the
+    cofactors. Short numbers are finished by the binary method.
+  */
+  IntVector gcd(const IntVector &lhs, const IntVector &rhs) {
+    bool isSwapped = less(lhs, rhs);
+    IntVector tmpLhs = isSwapped ? rhs : lhs;
+    IntVector tmpRhs = isSwapped ? lhs : rhs;
+
+    while (tmpRhs.size() > 2) {
+      if (tmpRhs.size() >= HALF_GCD_CUTOFF && tmpRhs.size() > tmpLhs.size() / 2 + 1) {
+        halfGcd(tmpLhs, tmpRhs, nullptr);
+      } else {
+        gcdStep(tmpLhs, tmpRhs, nullptr);
+      }
+    }
 
-    for (size_t i = rhs.size() - 2; i != SIZE_MAX; i--) {
+    if (tmpRhs.size() == 1 && tmpRhs.front() == 0) {
+      return tmpLhs;
+    }
+    if (tmpLhs.size() > 2) {
       IntVector modVal;
-      modVal.push_back(rhs[i] % base);
-      modVal.push_back(rhs[i] / base);
-      modVal.insert(modVal.end(), diff.begin(), diff.end());
-      toSignificantDigits(modVal);
-
-      IntVector intVect{0};
-      IntVector doubledRes = shortMultiply(val, 2, base);
-      intVect.insert(intVect.end(), doubledRes.begin(), doubledRes.end());
-
-      int64_t left = 0;
-      int64_t right = base;
-
-      while (left < right) {
-        intVect.front() = (left + right) / 2;
-        doubledRes = shortMultiply(intVect, intVect.front(), base);
-        if (greater(doubledRes, modVal)) {
-          right = intVect.front();
-        } else {
-          left = intVect.front() + 1;
-        }
+      divide(tmpLhs, tmpRhs, modVal);
+      tmpLhs = std::move(tmpRhs);
+      tmpRhs = std::move(modVal);
+    }
+
+    auto toUint128 = [](const IntVector &val) {
+      return val.size() == 1 ? uint128_t(val.front()) : (uint128_t(val[1]) << INT_BASE_SIZE) | val[0];
+    };
+    uint128_t val = binaryGcd(toUint128(tmpLhs), toUint128(tmpRhs));
+
+    IntVector res{uint64_t(val), uint64_t(val >> INT_BASE_SIZE)};
+    toSignificantDigits(res);
+    return res;
+  }
+
+  /*
+    Extended GCD by Lehmer's method. Along with the numbers their factors by lhs are kept, the factors by rhs are
+    restored from them at the end. Short numbers are finished by Euclid's steps.
+  */
+  IntVector gcdExtended(const IntVector &lhs, const IntVector &rhs, SignedIntVector &lhsFactor) {
+    bool isSwapped = less(lhs, rhs);
+    IntVector tmpLhs = isSwapped ? rhs : lhs;
+    IntVector tmpRhs = isSwapped ? lhs : rhs;
+    SignedIntVector tmpLhsFactor{IntVector{isSwapped ? 0U : 1U}, false};
+    SignedIntVector tmpRhsFactor{IntVector{isSwapped ? 1U : 0U}, false};
+    std::array<int64_t, 4> cofactors{};
+
+    while (tmpRhs.size() != 1 || tmpRhs.front() != 0) {
+      if (tmpRhs.size() > 2 && lehmerCofactors(tmpLhs, tmpRhs, cofactors)) {
+        IntVector val = linearCombination(tmpLhs, cofactors[0], tmpRhs, cofactors[1]);
+        tmpRhs = linearCombination(tmpLhs, cofactors[2], tmpRhs, cofactors[3]);
+        tmpLhs = std::move(val);
+
+        SignedIntVector factor = signedAdd(signedShortMultiply(tmpLhsFactor, cofactors[0]),
+                                           signedShortMultiply(tmpRhsFactor, cofactors[1]));
+        tmpRhsFactor = signedAdd(signedShortMultiply(tmpLhsFactor, cofactors[2]),
+                                 signedShortMultiply(tmpRhsFactor, cofactors[3]));
+        tmpLhsFactor = std::move(factor);
+      } else {
+        IntVector modVal;
+        IntVector quotient = divide(tmpLhs, tmpRhs, modVal);
+        tmpLhs = std::move(tmpRhs);
+        tmpRhs = std::move(modVal);
+
+        SignedIntVector factor = signedSubstract(
+            tmpLhsFactor, SignedIntVector{multiply(quotient, tmpRhsFactor.intVect), tmpRhsFactor.sign});
+        tmpLhsFactor = std::move(tmpRhsFactor);
+        tmpRhsFactor = std::move(factor);
       }
+    }
 
-      intVect.front() = right - 1;
+    lhsFactor = std::move(tmpLhsFactor);
+    return tmpLhs;
+  }
 
-      diff = substract(modVal, shortMultiply(intVect, intVect.front(), base), base);
-      val.insert(val.begin(), intVect.begin(), intVect.begin() + 1);
+  // Window sizes minimizing the number of multiplications for the exponent of bitsNum bits
+  size_t getWindowSize(size_t bitsNum) {
+    if (bitsNum > 671) {
+      return 6;
+    }
+    if (bitsNum > 239) {
+      return 5;
+    }
+    if (bitsNum > 79) {
+      return 4;
     }
+    if (bitsNum > 23) {
+      return 3;
+    }
+    if (bitsNum > 7) {
+      return 2;
+    }
+    return 1;
+  }
 
-    return val;
+  /*
+    Montgomery's reduction T * BASE^(-n) modulo M of T < M * BASE^n, where M is odd and has n limbs. The lowest limbs of
+    T are zeroed one by one by adding M multiplied by T[i] * (-M^(-1)) modulo BASE, then T is shifted by n limbs.
+  */
+  IntVector montgomeryReduce(IntVector val, const IntVector &mod, uint64_t modInv) {
+    size_t size = mod.size();
+    val.resize(size * 2 + 1, 0);
+
+    for (size_t i = 0; i < size; i++) {
+      uint64_t factor = val[i] * modInv;
+      uint64_t carry = 0;
+
+      for (size_t j = 0; j < size; j++) {
+        uint128_t prod = uint128_t(factor) * mod[j] + val[i + j] + carry;
+        val[i + j] = uint64_t(prod);
+        carry = uint64_t(prod >> INT_BASE_SIZE);
+      }
+
+      for (size_t j = i + size; carry != 0; j++) {
+        val[j] += carry;
+        carry = val[j] < carry ? 1 : 0;
+      }
+    }
+
+    IntVector res(val.begin() + ptrdiff_t(size), val.end());
+    toSignificantDigits(res);
+
+    if (!less(res, mod)) {
+      res = substract(res, mod);
+    }
+    return res;
+  }
+
+  /*
+    Barrett's reduction of T < M^2, where M has n limbs and MU = BASE^(2n) / M. The quotient is estimated as
+    (T / BASE^(n-1)) * MU / BASE^(n+1), it is less than the exact one by at most 2.
+  */
+  IntVector barrettReduce(const IntVector &val, const IntVector &mod, const IntVector &mu) {
+    if (less(val, mod)) {
+      return val;
+    }
+
+    size_t size = mod.size();
+    IntVector quotient = getLimbs(multiply(getLimbs(val, size - 1, val.size()), mu), size + 1, val.size());
+    IntVector res = substract(val, multiply(quotient, mod));
+
+    while (!less(res, mod)) {
+      res = substract(res, mod);
+    }
+    return res;
+  }
+
+  SignedIntVector signedAdd(const SignedIntVector &lhs, const SignedIntVector &rhs) {
+    SignedIntVector res;
+
+    if (lhs.sign == rhs.sign) {
+      res = {addToSignificantDigits(lhs.intVect, rhs.intVect), lhs.sign};
+    } else if (!less(lhs.intVect, rhs.intVect)) {
+      res = {substract(lhs.intVect, rhs.intVect), lhs.sign};
+    } else {
+      res = {substract(rhs.intVect, lhs.intVect), rhs.sign};
+    }
+
+    if (res.intVect.size() == 1 && res.intVect.front() == 0) {
+      res.sign = false;
+    }
+    return res;
+  }
+
+  SignedIntVector signedSubstract(const SignedIntVector &lhs, const SignedIntVector &rhs) {
+    return signedAdd(lhs, SignedIntVector{rhs.intVect, !rhs.sign});
+  }
+
+  SignedIntVector signedShortMultiply(const SignedIntVector &lhs, int64_t rhs) {
+    SignedIntVector res{shortMultiply(lhs.intVect, uint64_t(std::abs(rhs))), lhs.sign != (rhs < 0)};
+    if (res.intVect.size() == 1 && res.intVect.front() == 0) {
+      res.sign = false;
+    }
+    return res;
+  }
+
+  SignedIntVector signedShortDivide(const SignedIntVector &lhs, int64_t rhs) {
+    SignedIntVector res{shortDivide(lhs.intVect, uint64_t(std::abs(rhs))), lhs.sign != (rhs < 0)};
+    if (res.intVect.size() == 1 && res.intVect.front() == 0) {
+      res.sign = false;
+    }
+    return res;
+  }
+
+  /*
+    Pool of the threads used for multiplication, it is absent while multiplication is serial. The pool is only accessed
+    by std::atomic_load and std::atomic_store, so it can be replaced during calculations: the running ones keep the
+    previous pool until they finish.
+  */
+  std::shared_ptr<ThreadPool> &getThreadPool() {
+    static std::shared_ptr<ThreadPool> pool;
+    return pool;
+  }
+
+  // Running independent tasks of multiplying numbers of the given size in parallel if it is worth it
+  void runTasks(const std::vector<std::function<void()>> &tasks, size_t size) {
+    std::shared_ptr<ThreadPool> pool = size >= PARALLEL_MULTIPLY_CUTOFF ? std::atomic_load(&getThreadPool()) : nullptr;
+
+    if (pool) {
+      pool->run(tasks);
+      return;
+    }
+
+    for (const auto &task : tasks) {
+      task();
+    }
   }
 
-  void getSqrtDiff(const IntVector &rhs, const int64_t &base, IntVector &val, IntVector &diff) {
-    int64_t tmpVal = rhs.back() - val.front() * val.front();
-    diff.push_back(tmpVal % base);
-    if (tmpVal >= base) {
-      diff.push_back(tmpVal / base);
+  // Running func(first, last) on the ranges of rangeSize values covering [0, size) as independent tasks
+  void runRangeTasks(size_t size, size_t rangeSize, const std::function<void(size_t, size_t)> &func) {
+    std::vector<std::function<void()>> tasks;
+    for (size_t first = 0; first < size; first += rangeSize) {
+      tasks.emplace_back([&func, first, last = std::min(first + rangeSize, size)] { func(first, last); });
     }
+    runTasks(tasks, size);
   }
 }
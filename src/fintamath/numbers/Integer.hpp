@@ -1,8 +1,8 @@
 #pragma once
 
 #include <memory>
-#include <vector>
 
+#include "fintamath/numbers/IntVector.hpp"
 #include "fintamath/numbers/Number.hpp"
 
 namespace fintamath {
@@ -16,20 +16,187 @@ namespace fintamath {
 
     std::string toString() const override;
 
+    // Number of decimal digits
     int64_t getSize() const;
 
+    size_t getLimbsNum() const;
+
+    size_t getBitsNum() const;
+
+    // Estimates of the logarithms of the absolute value, -inf for zero
+    double getLog2() const;
+
+    double getLog10() const;
+
     Integer sqrt() const;
 
+    Integer sqrtRem(Integer &remainder) const;
+
+    Integer square() const;
+
+    Integer divMod(const Integer &rhs, Integer &remainder) const;
+
+    Integer divExact(const Integer &rhs) const;
+
+    Integer gcd(const Integer &rhs) const;
+
+    Integer gcdExtended(const Integer &rhs, Integer &lhsFactor, Integer &rhsFactor) const;
+
+    Integer powMod(const Integer &exp, const Integer &mod) const;
+
+    // Multiplication and truncating division by 10^n
+    Integer &shiftDecimalLeft(size_t n);
+
+    Integer &shiftDecimalRight(size_t n);
+
+    // Number of threads used to multiply long Integers, 1 by default. Running calculations finish with the old number
+    static void setThreadsNum(size_t threadsNum);
+
+    static size_t getThreadsNum();
+
     Integer &operator%=(const Integer &rhs);
 
     Integer operator%(const Integer &rhs) const;
 
+    template <typename RhsType, typename = std::enable_if_t<std::is_integral_v<RhsType>>>
+    friend Integer &operator+=(Integer &lhs, RhsType rhs) {
+      return lhs.add(int64_t(rhs));
+    }
+
+    template <typename RhsType, typename = std::enable_if_t<std::is_integral_v<RhsType>>>
+    friend Integer &operator-=(Integer &lhs, RhsType rhs) {
+      return lhs.substract(int64_t(rhs));
+    }
+
+    template <typename RhsType, typename = std::enable_if_t<std::is_integral_v<RhsType>>>
+    friend Integer &operator*=(Integer &lhs, RhsType rhs) {
+      return lhs.multiply(int64_t(rhs));
+    }
+
+    template <typename RhsType, typename = std::enable_if_t<std::is_integral_v<RhsType>>>
+    friend Integer &operator/=(Integer &lhs, RhsType rhs) {
+      return lhs.divide(int64_t(rhs));
+    }
+
+    template <typename RhsType, typename = std::enable_if_t<std::is_integral_v<RhsType>>>
+    friend Integer &operator%=(Integer &lhs, RhsType rhs) {
+      return lhs.mod(int64_t(rhs));
+    }
+
+    template <typename RhsType, typename = std::enable_if_t<std::is_integral_v<RhsType>>>
+    friend Integer operator+(const Integer &lhs, RhsType rhs) {
+      return Integer(lhs).add(int64_t(rhs));
+    }
+
+    template <typename LhsType, typename = std::enable_if_t<std::is_integral_v<LhsType>>>
+    friend Integer operator+(LhsType lhs, const Integer &rhs) {
+      return Integer(rhs).add(int64_t(lhs));
+    }
+
+    template <typename RhsType, typename = std::enable_if_t<std::is_integral_v<RhsType>>>
+    friend Integer operator-(const Integer &lhs, RhsType rhs) {
+      return Integer(lhs).substract(int64_t(rhs));
+    }
+
+    template <typename LhsType, typename = std::enable_if_t<std::is_integral_v<LhsType>>>
+    friend Integer operator-(LhsType lhs, const Integer &rhs) {
+      return Integer(rhs).substract(int64_t(lhs)).negate();
+    }
+
+    template <typename RhsType, typename = std::enable_if_t<std::is_integral_v<RhsType>>>
+    friend Integer operator*(const Integer &lhs, RhsType rhs) {
+      return Integer(lhs).multiply(int64_t(rhs));
+    }
+
+    template <typename LhsType, typename = std::enable_if_t<std::is_integral_v<LhsType>>>
+    friend Integer operator*(LhsType lhs, const Integer &rhs) {
+      return Integer(rhs).multiply(int64_t(lhs));
+    }
+
+    template <typename RhsType, typename = std::enable_if_t<std::is_integral_v<RhsType>>>
+    friend Integer operator/(const Integer &lhs, RhsType rhs) {
+      return Integer(lhs).divide(int64_t(rhs));
+    }
+
+    template <typename LhsType, typename = std::enable_if_t<std::is_integral_v<LhsType>>>
+    friend Integer operator/(LhsType lhs, const Integer &rhs) {
+      return Integer(int64_t(lhs)).divide(rhs);
+    }
+
+    template <typename RhsType, typename = std::enable_if_t<std::is_integral_v<RhsType>>>
+    friend Integer operator%(const Integer &lhs, RhsType rhs) {
+      return Integer(lhs).mod(int64_t(rhs));
+    }
+
+    template <typename LhsType, typename = std::enable_if_t<std::is_integral_v<LhsType>>>
+    friend Integer operator%(LhsType lhs, const Integer &rhs) {
+      return Integer(int64_t(lhs)).mod(rhs);
+    }
+
+    template <typename RhsType, typename = std::enable_if_t<std::is_integral_v<RhsType>>>
+    friend bool operator==(const Integer &lhs, RhsType rhs) {
+      return lhs.compare(int64_t(rhs)) == 0;
+    }
+
+    template <typename LhsType, typename = std::enable_if_t<std::is_integral_v<LhsType>>>
+    friend bool operator==(LhsType lhs, const Integer &rhs) {
+      return rhs.compare(int64_t(lhs)) == 0;
+    }
+
+    template <typename RhsType, typename = std::enable_if_t<std::is_integral_v<RhsType>>>
+    friend bool operator!=(const Integer &lhs, RhsType rhs) {
+      return lhs.compare(int64_t(rhs)) != 0;
+    }
+
+    template <typename LhsType, typename = std::enable_if_t<std::is_integral_v<LhsType>>>
+    friend bool operator!=(LhsType lhs, const Integer &rhs) {
+      return rhs.compare(int64_t(lhs)) != 0;
+    }
+
+    template <typename RhsType, typename = std::enable_if_t<std::is_integral_v<RhsType>>>
+    friend bool operator<(const Integer &lhs, RhsType rhs) {
+      return lhs.compare(int64_t(rhs)) < 0;
+    }
+
+    template <typename LhsType, typename = std::enable_if_t<std::is_integral_v<LhsType>>>
+    friend bool operator<(LhsType lhs, const Integer &rhs) {
+      return rhs.compare(int64_t(lhs)) > 0;
+    }
+
+    template <typename RhsType, typename = std::enable_if_t<std::is_integral_v<RhsType>>>
+    friend bool operator>(const Integer &lhs, RhsType rhs) {
+      return lhs.compare(int64_t(rhs)) > 0;
+    }
+
+    template <typename LhsType, typename = std::enable_if_t<std::is_integral_v<LhsType>>>
+    friend bool operator>(LhsType lhs, const Integer &rhs) {
+      return rhs.compare(int64_t(lhs)) < 0;
+    }
+
+    template <typename RhsType, typename = std::enable_if_t<std::is_integral_v<RhsType>>>
+    friend bool operator<=(const Integer &lhs, RhsType rhs) {
+      return lhs.compare(int64_t(rhs)) <= 0;
+    }
+
+    template <typename LhsType, typename = std::enable_if_t<std::is_integral_v<LhsType>>>
+    friend bool operator<=(LhsType lhs, const Integer &rhs) {
+      return rhs.compare(int64_t(lhs)) >= 0;
+    }
+
+    template <typename RhsType, typename = std::enable_if_t<std::is_integral_v<RhsType>>>
+    friend bool operator>=(const Integer &lhs, RhsType rhs) {
+      return lhs.compare(int64_t(rhs)) >= 0;
+    }
+
+    template <typename LhsType, typename = std::enable_if_t<std::is_integral_v<LhsType>>>
+    friend bool operator>=(LhsType lhs, const Integer &rhs) {
+      return rhs.compare(int64_t(lhs)) <= 0;
+    }
+
   protected:
     bool equals(const Integer &rhs) const override;
 
-    bool less(const Integer &rhs) const override;
-
-    bool more(const Integer &rhs) const override;
+    int compare(const Integer &rhs) const override;
 
     Integer &add(const Integer &rhs) override;
 
@@ -48,29 +215,63 @@ namespace fintamath {
     Integer &mod(const Integer &rhs);
 
   private:
+    friend class ModContext;
+
+    int compare(int64_t rhs) const;
+
+    Integer &add(int64_t rhs);
+
+    Integer &substract(int64_t rhs);
+
+    Integer &multiply(int64_t rhs);
+
+    Integer &divide(int64_t rhs);
+
+    Integer &mod(int64_t rhs);
+
+    Integer &addShort(uint64_t rhs, bool rhsSign);
+
     void parse(const std::string_view &str);
 
     void fixZero();
 
-    std::vector<int64_t> intVect{0};
+    IntVector getIntVector(size_t skippedZerosNum) const;
+
+    void expandZeros(size_t newZerosNum);
+
+    // The number is intVect * BASE^zerosNum, the lowest limb of intVect is not zero unless the number is zero
+    IntVector intVect{0};
+    size_t zerosNum{};
     bool sign{};
   };
 
-  template <typename RhsType,
-            typename = std::enable_if_t<std::is_convertible_v<RhsType, Integer> && !std::is_same_v<Integer, RhsType>>>
-  Integer &operator%=(Integer &lhs, const RhsType &rhs) {
-    return lhs %= LhsType(rhs);
-  }
-
-  template <typename RhsType,
-            typename = std::enable_if_t<std::is_convertible_v<RhsType, Integer> && !std::is_same_v<Integer, RhsType>>>
-  Integer operator%(const Integer &lhs, const RhsType &rhs) {
-    return lhs % Integer(rhs);
-  }
-
-  template <typename LhsType,
-            typename = std::enable_if_t<std::is_convertible_v<LhsType, Integer> && !std::is_same_v<LhsType, Integer>>>
-  Integer operator%(const LhsType &lhs, const Integer &rhs) {
-    return Integer(lhs) % rhs;
-  }
+  // Modulus with the precomputed constants of reduction by it, reused by all the calculations modulo the same number
+  class ModContext {
+  public:
+    explicit ModContext(const Integer &rhs);
+
+    const Integer &getMod() const;
+
+    Integer powMod(const Integer &base, const Integer &exp) const;
+
+  private:
+    IntVector toForm(const IntVector &rhs) const;
+
+    IntVector fromForm(const IntVector &rhs) const;
+
+    IntVector multiplyForm(const IntVector &lhs, const IntVector &rhs) const;
+
+    Integer mod;
+    IntVector modVect;
+
+    // Montgomery's reduction for short odd moduli, Barrett's one otherwise
+    bool isMontgomery{};
+
+    // -mod^(-1) modulo 2^64 and BASE^(2n) modulo mod for Montgomery's reduction
+    uint64_t modInv{};
+    IntVector r2;
+
+    // BASE^(2n) / mod for Barrett's reduction
+    IntVector mu;
+  };
 }
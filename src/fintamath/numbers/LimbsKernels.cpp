@@ -0,0 +1,159 @@
+#include "fintamath/numbers/LimbsKernels.hpp"
+
+#ifdef FINTAMATH_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace fintamath {
+  __extension__ typedef unsigned __int128 uint128_t;
+
+  constexpr uint64_t INT_BASE_SIZE = 64;
+
+  uint64_t addLimbsScalar(uint64_t *res, const uint64_t *lhs, const uint64_t *rhs, size_t size, uint64_t carry) {
+    for (size_t i = 0; i < size; i++) {
+      uint128_t sum = uint128_t(lhs[i]) + rhs[i] + carry;
+      res[i] = uint64_t(sum);
+      carry = uint64_t(sum >> INT_BASE_SIZE);
+    }
+    return carry;
+  }
+
+  uint64_t substractLimbsScalar(uint64_t *res, const uint64_t *lhs, const uint64_t *rhs, size_t size, uint64_t borrow) {
+    for (size_t i = 0; i < size; i++) {
+      uint64_t limb = lhs[i];
+      uint64_t diff = limb - rhs[i];
+      uint64_t newBorrow = limb < rhs[i] ? 1 : 0;
+      newBorrow += diff < borrow ? 1 : 0;
+      res[i] = diff - borrow;
+      borrow = newBorrow;
+    }
+    return borrow;
+  }
+
+#ifdef FINTAMATH_X86_SIMD
+  /*
+    Vector kernels add all the lanes of a block at once and defer the carries. A lane generates a carry if its sum
+    overflows, and propagates the incoming carry if its sum is 2^64 - 1. With the lanes as bits of masks g and p, the
+    incoming carries of all the lanes are the bits of ((g << 1) + p + carry) ^ p, and the next bit is the carry out of
+    the block. The fix-up pass adds one to the lanes with the incoming carry. Substraction is the same with borrows,
+    where a lane propagates the incoming borrow if its difference is 0.
+  */
+  __attribute__((target("avx2"))) uint64_t addLimbsAvx2(uint64_t *res, const uint64_t *lhs, const uint64_t *rhs,
+                                                        size_t size, uint64_t carry) {
+    const __m256i signBit = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i allOnes = _mm256_set1_epi64x(-1);
+    const __m256i laneBits = _mm256_set_epi64x(8, 4, 2, 1);
+
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+      __m256i lhsVal = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs + i));
+      __m256i rhsVal = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rhs + i));
+      __m256i sum = _mm256_add_epi64(lhsVal, rhsVal);
+
+      // AVX2 has only signed comparison, so the unsigned sum < lhs is checked with the highest bits flipped
+      __m256i generated = _mm256_cmpgt_epi64(_mm256_xor_si256(lhsVal, signBit), _mm256_xor_si256(sum, signBit));
+      __m256i propagated = _mm256_cmpeq_epi64(sum, allOnes);
+      auto generatedMask = uint64_t(_mm256_movemask_pd(_mm256_castsi256_pd(generated)));
+      auto propagatedMask = uint64_t(_mm256_movemask_pd(_mm256_castsi256_pd(propagated)));
+
+      uint64_t carries = ((generatedMask << 1) + propagatedMask + carry) ^ propagatedMask;
+      __m256i carriesVal = _mm256_and_si256(_mm256_set1_epi64x(int64_t(carries)), laneBits);
+      sum = _mm256_sub_epi64(sum, _mm256_cmpeq_epi64(carriesVal, laneBits));
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(res + i), sum);
+      carry = carries >> 4;
+    }
+
+    return addLimbsScalar(res + i, lhs + i, rhs + i, size - i, carry);
+  }
+
+  __attribute__((target("avx2"))) uint64_t substractLimbsAvx2(uint64_t *res, const uint64_t *lhs, const uint64_t *rhs,
+                                                              size_t size, uint64_t borrow) {
+    const __m256i signBit = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i laneBits = _mm256_set_epi64x(8, 4, 2, 1);
+
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+      __m256i lhsVal = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs + i));
+      __m256i rhsVal = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rhs + i));
+      __m256i diff = _mm256_sub_epi64(lhsVal, rhsVal);
+
+      __m256i generated = _mm256_cmpgt_epi64(_mm256_xor_si256(rhsVal, signBit), _mm256_xor_si256(lhsVal, signBit));
+      __m256i propagated = _mm256_cmpeq_epi64(diff, _mm256_setzero_si256());
+      auto generatedMask = uint64_t(_mm256_movemask_pd(_mm256_castsi256_pd(generated)));
+      auto propagatedMask = uint64_t(_mm256_movemask_pd(_mm256_castsi256_pd(propagated)));
+
+      uint64_t borrows = ((generatedMask << 1) + propagatedMask + borrow) ^ propagatedMask;
+      __m256i borrowsVal = _mm256_and_si256(_mm256_set1_epi64x(int64_t(borrows)), laneBits);
+      diff = _mm256_add_epi64(diff, _mm256_cmpeq_epi64(borrowsVal, laneBits));
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(res + i), diff);
+      borrow = borrows >> 4;
+    }
+
+    return substractLimbsScalar(res + i, lhs + i, rhs + i, size - i, borrow);
+  }
+
+  __attribute__((target("avx512f"))) uint64_t addLimbsAvx512(uint64_t *res, const uint64_t *lhs, const uint64_t *rhs,
+                                                             size_t size, uint64_t carry) {
+    const __m512i allOnes = _mm512_set1_epi64(-1);
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+      __m512i lhsVal = _mm512_loadu_si512(lhs + i);
+      __m512i sum = _mm512_add_epi64(lhsVal, _mm512_loadu_si512(rhs + i));
+
+      uint64_t generatedMask = _mm512_cmplt_epu64_mask(sum, lhsVal);
+      uint64_t propagatedMask = _mm512_cmpeq_epi64_mask(sum, allOnes);
+
+      uint64_t carries = ((generatedMask << 1) + propagatedMask + carry) ^ propagatedMask;
+      sum = _mm512_mask_sub_epi64(sum, __mmask8(carries), sum, allOnes);
+
+      _mm512_storeu_si512(res + i, sum);
+      carry = carries >> 8;
+    }
+
+    return addLimbsScalar(res + i, lhs + i, rhs + i, size - i, carry);
+  }
+
+  __attribute__((target("avx512f"))) uint64_t substractLimbsAvx512(uint64_t *res, const uint64_t *lhs,
+                                                                   const uint64_t *rhs, size_t size, uint64_t borrow) {
+    const __m512i allOnes = _mm512_set1_epi64(-1);
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+      __m512i lhsVal = _mm512_loadu_si512(lhs + i);
+      __m512i rhsVal = _mm512_loadu_si512(rhs + i);
+      __m512i diff = _mm512_sub_epi64(lhsVal, rhsVal);
+
+      uint64_t generatedMask = _mm512_cmplt_epu64_mask(lhsVal, rhsVal);
+      uint64_t propagatedMask = _mm512_cmpeq_epi64_mask(diff, _mm512_setzero_si512());
+
+      uint64_t borrows = ((generatedMask << 1) + propagatedMask + borrow) ^ propagatedMask;
+      diff = _mm512_mask_add_epi64(diff, __mmask8(borrows), diff, allOnes);
+
+      _mm512_storeu_si512(res + i, diff);
+      borrow = borrows >> 8;
+    }
+
+    return substractLimbsScalar(res + i, lhs + i, rhs + i, size - i, borrow);
+  }
+#endif
+
+  // Choosing the kernels by the features of the CPU once
+  const LimbsKernels &getLimbsKernels() {
+    static const LimbsKernels kernels = [] {
+#ifdef FINTAMATH_X86_SIMD
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx512f")) {
+        return LimbsKernels{addLimbsAvx512, substractLimbsAvx512};
+      }
+      if (__builtin_cpu_supports("avx2")) {
+        return LimbsKernels{addLimbsAvx2, substractLimbsAvx2};
+      }
+#endif
+      return LimbsKernels{addLimbsScalar, substractLimbsScalar};
+    }();
+    return kernels;
+  }
+}
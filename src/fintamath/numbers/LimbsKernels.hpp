@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define FINTAMATH_X86_SIMD
+#endif
+
+/*
+  Kernels of limb addition and substraction used by Integer. They are internal, but declared here, so each of them can
+  be tested regardless of the one chosen for the current CPU.
+*/
+namespace fintamath {
+  // Kernel adding or substracting size limbs with the incoming carry. res may coincide with lhs. Returns the carry out
+  using LimbsKernel =
+      uint64_t (*)(uint64_t *res, const uint64_t *lhs, const uint64_t *rhs, size_t size, uint64_t carry);
+
+  // Kernels for the instruction set of the current CPU
+  struct LimbsKernels {
+    LimbsKernel add;
+    LimbsKernel substract;
+  };
+
+  uint64_t addLimbsScalar(uint64_t *res, const uint64_t *lhs, const uint64_t *rhs, size_t size, uint64_t carry);
+
+  uint64_t substractLimbsScalar(uint64_t *res, const uint64_t *lhs, const uint64_t *rhs, size_t size, uint64_t borrow);
+
+#ifdef FINTAMATH_X86_SIMD
+  uint64_t addLimbsAvx2(uint64_t *res, const uint64_t *lhs, const uint64_t *rhs, size_t size, uint64_t carry);
+
+  uint64_t substractLimbsAvx2(uint64_t *res, const uint64_t *lhs, const uint64_t *rhs, size_t size, uint64_t borrow);
+
+  uint64_t addLimbsAvx512(uint64_t *res, const uint64_t *lhs, const uint64_t *rhs, size_t size, uint64_t carry);
+
+  uint64_t substractLimbsAvx512(uint64_t *res, const uint64_t *lhs, const uint64_t *rhs, size_t size, uint64_t borrow);
+#endif
+
+  const LimbsKernels &getLimbsKernels();
+}
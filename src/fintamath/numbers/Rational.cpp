@@ -4,9 +4,6 @@
 #include <stdexcept>
 
 namespace fintamath {
-  static Integer gcd(const Integer &lhs, const Integer &rhs);
-  static Integer lcm(const Integer &lhs, const Integer &rhs);
-
   Rational::Rational(const std::string_view &str) {
     parse(str);
   }
@@ -23,8 +20,25 @@ namespace fintamath {
     fixNegative();
   }
 
+  /*
+    Rounding half away from zero, the same as in toString(precision): |x| * 10^precision is divided with the remainder
+    and rounded up when the remainder is at least a half. The result is built with the power of 10 denominator.
+  */
   Rational Rational::round(int64_t precision) const {
-    return Rational(toString(precision));
+    Integer val = numerator;
+    val.shiftDecimalLeft(size_t(precision));
+
+    Integer remainder;
+    val = val.divMod(denominator, remainder);
+    if (remainder * 2 >= denominator) {
+      val += 1;
+    }
+
+    Rational res = val;
+    if (val != 0) {
+      res.sign = sign;
+    }
+    return res.scaleByPow10(-precision);
   }
 
   Integer Rational::getInteger() const {
@@ -39,18 +53,55 @@ namespace fintamath {
     return denominator;
   }
 
+  // Integer part and the numerator of the fractional part by one division, the same as getInteger and getNumerator
+  Integer Rational::splitIntegerFraction(Integer &fractionNumerator) const {
+    return numerator.divMod(denominator, fractionNumerator);
+  }
+
+  // The numerator and the denominator are coprime, so are their squares and the result needs no reduction
+  Rational Rational::square() const {
+    Rational res;
+    res.numerator = numerator.square();
+    res.denominator = denominator.square();
+    return res;
+  }
+
+  /*
+    Multiplication by 10^n. The fraction is irreducible, so 10^n can only have common factors with the other part,
+    which are cancelled before multiplying.
+  */
+  Rational &Rational::scaleByPow10(int64_t n) {
+    if (numerator == 0) {
+      return *this;
+    }
+
+    Integer pow10 = 1;
+    pow10.shiftDecimalLeft(size_t(n < 0 ? -n : n));
+
+    Integer &multiplied = n < 0 ? denominator : numerator;
+    Integer &reduced = n < 0 ? numerator : denominator;
+
+    Integer gcdVal = reduced.gcd(pow10);
+    if (gcdVal != 1) {
+      reduced = reduced.divExact(gcdVal);
+      pow10 = pow10.divExact(gcdVal);
+    }
+    multiplied *= pow10;
+
+    return *this;
+  }
+
   std::string Rational::toString(int64_t precision) const {
     const int64_t base = 10;
     const int64_t roundUp = 5;
 
-    std::string precisionStr(size_t(precision) + 2, '0');
-    precisionStr.front() = '1';
-
-    Integer val = numerator * Integer(precisionStr) / denominator;
+    Integer val = numerator;
+    val.shiftDecimalLeft(size_t(precision) + 1);
+    val /= denominator;
     if (val % base >= roundUp) {
       val += base;
     }
-    val /= base;
+    val.shiftDecimalRight(1);
 
     std::string strVal = val.toString();
     if (strVal.size() <= size_t(precision)) {
@@ -92,49 +143,118 @@ namespace fintamath {
     return sign == rhs.sign && numerator == rhs.numerator && denominator == rhs.denominator;
   }
 
-  bool Rational::less(const Rational &rhs) const {
-    Rational lhs = *this;
-    Rational tmpRhs = rhs;
-    toCommonDenominators(lhs, tmpRhs);
-    return (lhs.numerator < tmpRhs.numerator);
-  }
+  /*
+    Numbers of different signs and zeros are compared at once. Otherwise the magnitudes a/b and c/d are compared as the
+    products a*d and c*b. A product of numbers of m and n bits has m + n - 1 or m + n bits, so the products are
+    calculated only if these bit lengths are close.
+  */
+  int Rational::compare(const Rational &rhs) const {
+    if (sign != rhs.sign) {
+      return sign ? -1 : 1;
+    }
 
-  bool Rational::more(const Rational &rhs) const {
-    Rational lhs = *this;
-    Rational tmpRhs = rhs;
-    toCommonDenominators(lhs, tmpRhs);
-    return (lhs.numerator > tmpRhs.numerator);
+    int res = 0;
+
+    if (numerator == 0 || rhs.numerator == 0) {
+      res = numerator == 0 ? (rhs.numerator == 0 ? 0 : -1) : 1;
+    } else if (denominator == rhs.denominator) {
+      res = numerator == rhs.numerator ? 0 : (numerator < rhs.numerator ? -1 : 1);
+    } else {
+      size_t lhsBitsNum = numerator.getBitsNum() + rhs.denominator.getBitsNum();
+      size_t rhsBitsNum = rhs.numerator.getBitsNum() + denominator.getBitsNum();
+
+      if (lhsBitsNum > rhsBitsNum + 1) {
+        res = 1;
+      } else if (rhsBitsNum > lhsBitsNum + 1) {
+        res = -1;
+      } else {
+        Integer lhsProd = numerator * rhs.denominator;
+        Integer rhsProd = rhs.numerator * denominator;
+        res = lhsProd == rhsProd ? 0 : (lhsProd < rhsProd ? -1 : 1);
+      }
+    }
+
+    return sign ? -res : res;
   }
 
+  /*
+    Henrici's addition. With g = gcd(b, d) the sum a/b + c/d is t / (b/g * d), where t = a * (d/g) + c * (b/g). Common
+    factors of t and the denominator can only divide g, so the result is reduced by gcd(t, g) instead of the full gcd.
+  */
   Rational &Rational::add(const Rational &rhs) {
-    Rational tmpRhs = rhs;
-    toCommonDenominators(*this, tmpRhs);
-    numerator += tmpRhs.numerator;
-    toIrreducibleRational();
+    Integer lhsNumerator = sign ? -numerator : numerator;
+    Integer rhsNumerator = rhs.sign ? -rhs.numerator : rhs.numerator;
+    Integer gcdVal = denominator.gcd(rhs.denominator);
+
+    Integer resNumerator;
+    Integer resDenominator;
+
+    if (gcdVal == 1) {
+      resNumerator = lhsNumerator * rhs.denominator + rhsNumerator * denominator;
+      resDenominator = denominator * rhs.denominator;
+    } else {
+      Integer lhsDenominator = denominator.divExact(gcdVal);
+      resNumerator = lhsNumerator * rhs.denominator.divExact(gcdVal) + rhsNumerator * lhsDenominator;
+
+      Integer numeratorGcd = resNumerator.gcd(gcdVal);
+      if (numeratorGcd != 1) {
+        resNumerator = resNumerator.divExact(numeratorGcd);
+        resDenominator = lhsDenominator * rhs.denominator.divExact(numeratorGcd);
+      } else {
+        resDenominator = lhsDenominator * rhs.denominator;
+      }
+    }
+
+    numerator = std::move(resNumerator);
+    denominator = std::move(resDenominator);
+    sign = false;
+    fixNegative();
+    fixZero();
     return *this;
   }
 
   Rational &Rational::substract(const Rational &rhs) {
-    Rational tmpRhs = rhs;
-    toCommonDenominators(*this, tmpRhs);
-    numerator -= tmpRhs.numerator;
-    toIrreducibleRational();
-    return *this;
+    return add(Rational(rhs).negate());
   }
 
+  /*
+    Multiplication with the cross gcds: a/b * c/d = (a/gcd(a, d) * c/gcd(c, b)) / (b/gcd(c, b) * d/gcd(a, d)). The
+    factors are coprime after the divisions, so the result needs no reduction.
+  */
   Rational &Rational::multiply(const Rational &rhs) {
-    numerator *= rhs.numerator;
-    denominator *= rhs.denominator;
+    if (this == &rhs || equals(rhs)) {
+      return *this = square();
+    }
+
+    Integer lhsGcd = numerator.gcd(rhs.denominator);
+    Integer rhsGcd = rhs.numerator.gcd(denominator);
+
+    Integer resNumerator = numerator.divExact(lhsGcd) * rhs.numerator.divExact(rhsGcd);
+    Integer resDenominator = denominator.divExact(rhsGcd) * rhs.denominator.divExact(lhsGcd);
+
+    numerator = std::move(resNumerator);
+    denominator = std::move(resDenominator);
     sign = !((sign && rhs.sign) || (!sign && !rhs.sign));
-    toIrreducibleRational();
+    fixZero();
     return *this;
   }
 
+  // Division is the multiplication by d/c with the cross gcds gcd(a, c) and gcd(d, b)
   Rational &Rational::divide(const Rational &rhs) {
-    numerator *= rhs.denominator;
-    denominator *= rhs.numerator;
+    if (rhs.numerator == 0) {
+      throw std::domain_error("Div by zero");
+    }
+
+    Integer numeratorsGcd = numerator.gcd(rhs.numerator);
+    Integer denominatorsGcd = denominator.gcd(rhs.denominator);
+
+    Integer resNumerator = numerator.divExact(numeratorsGcd) * rhs.denominator.divExact(denominatorsGcd);
+    Integer resDenominator = denominator.divExact(denominatorsGcd) * rhs.numerator.divExact(numeratorsGcd);
+
+    numerator = std::move(resNumerator);
+    denominator = std::move(resDenominator);
     sign = !((sign && rhs.sign) || (!sign && !rhs.sign));
-    toIrreducibleRational();
+    fixZero();
     return *this;
   }
 
@@ -171,10 +291,8 @@ namespace fintamath {
     if (size_t(firstDotNum) != str.size()) {
       try {
         auto numeratorStr = str.substr(size_t(firstDotNum) + 1);
-        std::string denominatorStr(numeratorStr.size() + 1, '0');
-        denominatorStr.front() = '1';
         numerator = Integer(numeratorStr);
-        denominator = Integer(denominatorStr);
+        denominator.shiftDecimalLeft(numeratorStr.size());
       } catch (const std::invalid_argument &) {
         throw std::invalid_argument("Rational invalid input");
       }
@@ -207,44 +325,11 @@ namespace fintamath {
       throw std::domain_error("Div by zero");
     }
     fixNegative();
-    Integer gcdVal = gcd(numerator, denominator);
-    numerator /= gcdVal;
-    denominator /= gcdVal;
-    fixZero();
-  }
-
-  void Rational::toCommonDenominators(Rational &lhs, Rational &rhs) {
-    Integer lcmVal = lcm(lhs.denominator, rhs.denominator);
-
-    if (lhs.sign) {
-      lhs.numerator *= -1;
-    }
-    lhs.numerator *= (lcmVal / lhs.denominator);
-    lhs.denominator = lcmVal;
-    lhs.sign = false;
-
-    if (rhs.sign) {
-      rhs.numerator *= -1;
-    }
-    rhs.numerator *= (lcmVal / rhs.denominator);
-    rhs.denominator = lcmVal;
-    rhs.sign = false;
-  }
-
-  // Using Euclid's algorithm
-  static Integer gcd(const Integer &lhs, const Integer &rhs) {
-    Integer tmpLhs = lhs;
-    Integer tmpRhs = rhs;
-    while (tmpRhs != 0) {
-      Integer buff = tmpLhs % tmpRhs;
-      tmpLhs = tmpRhs;
-      tmpRhs = buff;
+    Integer gcdVal = numerator.gcd(denominator);
+    if (gcdVal != 1) {
+      numerator = numerator.divExact(gcdVal);
+      denominator = denominator.divExact(gcdVal);
     }
-    return tmpLhs;
-  }
-
-  // Using the formula lcm(a, b) = a * b / gcd(a, b)
-  static Integer lcm(const Integer &lhs, const Integer &rhs) {
-    return lhs * rhs / gcd(lhs, rhs);
+    fixZero();
   }
 }
@@ -27,12 +27,16 @@ namespace fintamath {
 
     Integer getDenominator() const;
 
+    Integer splitIntegerFraction(Integer &fractionNumerator) const;
+
+    Rational square() const;
+
+    Rational &scaleByPow10(int64_t n);
+
   protected:
     bool equals(const Rational &rhs) const override;
 
-    bool less(const Rational &rhs) const override;
-
-    bool more(const Rational &rhs) const override;
+    int compare(const Rational &rhs) const override;
 
     Rational &add(const Rational &rhs) override;
 
@@ -57,8 +61,6 @@ namespace fintamath {
 
     void toIrreducibleRational();
 
-    static void toCommonDenominators(Rational &lhs, Rational &rhs);
-
     Integer numerator = 0;
     Integer denominator = 1;
     bool sign{};
@@ -19,12 +19,8 @@ namespace fintamath::tests {
       return true;
     }
 
-    bool less(const TestComparable & /* rhs */) const override {
-      return true;
-    }
-
-    bool more(const TestComparable & /* rhs */) const override {
-      return true;
+    int compare(const TestComparable & /* rhs */) const override {
+      return 0;
     }
   };
 }
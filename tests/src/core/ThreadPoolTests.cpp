@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include "fintamath/core/ThreadPool.hpp"
+
+using namespace fintamath;
+
+TEST(ThreadPoolTests, getThreadsNumTest) {
+  EXPECT_EQ(ThreadPool(1).getThreadsNum(), 1U);
+  EXPECT_EQ(ThreadPool(3).getThreadsNum(), 3U);
+}
+
+TEST(ThreadPoolTests, runTest) {
+  ThreadPool pool(4);
+
+  std::vector<int64_t> vals(100);
+  std::vector<std::function<void()>> tasks;
+  for (size_t i = 0; i < vals.size(); i++) {
+    tasks.emplace_back([&vals, i] { vals[i] = int64_t(i * i); });
+  }
+  pool.run(tasks);
+
+  for (size_t i = 0; i < vals.size(); i++) {
+    EXPECT_EQ(vals[i], int64_t(i * i));
+  }
+
+  pool.run({});
+}
+
+TEST(ThreadPoolTests, nestedRunTest) {
+  ThreadPool pool(3);
+
+  std::atomic<int64_t> sum = 0;
+  std::vector<std::function<void()>> tasks;
+  for (size_t i = 0; i < 10; i++) {
+    tasks.emplace_back([&pool, &sum] {
+      std::vector<std::function<void()>> nestedTasks(10, [&sum] { sum++; });
+      pool.run(nestedTasks);
+    });
+  }
+  pool.run(tasks);
+
+  EXPECT_EQ(sum, 100);
+}
+
+TEST(ThreadPoolTests, exceptionTest) {
+  ThreadPool pool(2);
+
+  std::atomic<int64_t> finishedNum = 0;
+  std::vector<std::function<void()>> tasks(10, [&finishedNum] { finishedNum++; });
+  tasks.emplace_back([] { throw std::domain_error("Task error"); });
+
+  EXPECT_THROW(pool.run(tasks), std::domain_error);
+  EXPECT_EQ(finishedNum, 10);
+}
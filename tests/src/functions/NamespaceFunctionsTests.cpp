@@ -0,0 +1,21 @@
+#include <gtest/gtest.h>
+
+#include "fintamath/functions/NamespaceFunctions.hpp"
+
+#include "fintamath/numbers/Rational.hpp"
+
+using namespace fintamath;
+
+TEST(NamespaceFunctionsTests, getInversedPrecisionValTest) {
+  EXPECT_EQ(getInversedPrecisionVal(0), 1);
+  EXPECT_EQ(getInversedPrecisionVal(1), Rational(1, 10));
+  EXPECT_EQ(getInversedPrecisionVal(5), Rational(1, 100000));
+  EXPECT_EQ(getInversedPrecisionVal(30), Rational("0." + std::string(29, '0') + "1"));
+}
+
+TEST(NamespaceFunctionsTests, seriesTest) {
+  EXPECT_EQ(functions::exp(1, 30).toString(25), "2.7182818284590452353602875");
+  EXPECT_EQ(functions::ln(2, 30).toString(25), "0.6931471805599453094172321");
+  EXPECT_EQ(functions::sin(1, 30).toString(25), "0.8414709848078965066525023");
+  EXPECT_EQ(functions::sqrt(2, 30).toString(25), "1.4142135623730950488016887");
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include "fintamath/numbers/IntVector.hpp"
+
+using namespace fintamath;
+
+TEST(IntVectorTests, constructorTest) {
+  IntVector a;
+  EXPECT_TRUE(a.empty());
+  EXPECT_TRUE(a.isInline());
+
+  IntVector b{1, 2};
+  EXPECT_EQ(b.size(), 2U);
+  EXPECT_TRUE(b.isInline());
+
+  IntVector c(5, 7);
+  EXPECT_EQ(c.size(), 5U);
+  EXPECT_FALSE(c.isInline());
+  EXPECT_EQ(c.back(), 7U);
+}
+
+TEST(IntVectorTests, pushBackTest) {
+  IntVector a{1};
+  a.push_back(2);
+  EXPECT_TRUE(a.isInline());
+
+  a.push_back(3);
+  EXPECT_FALSE(a.isInline());
+  EXPECT_EQ(a.size(), 3U);
+  EXPECT_EQ(a[0], 1U);
+  EXPECT_EQ(a[1], 2U);
+  EXPECT_EQ(a[2], 3U);
+}
+
+TEST(IntVectorTests, copyMoveTest) {
+  IntVector a(10, 3);
+  IntVector b = a;
+  EXPECT_EQ(b.size(), 10U);
+  EXPECT_EQ(b.front(), 3U);
+
+  IntVector c = std::move(a);
+  EXPECT_EQ(c.size(), 10U);
+  EXPECT_TRUE(a.empty()); // NOLINT
+
+  IntVector d{4};
+  d = c;
+  EXPECT_EQ(d.size(), 10U);
+  d = IntVector{5};
+  EXPECT_EQ(d.size(), 1U);
+  EXPECT_EQ(d.front(), 5U);
+}
+
+TEST(IntVectorTests, insertEraseTest) {
+  IntVector a{1, 2};
+  a.insert(a.begin(), 2, 0);
+  EXPECT_EQ(a.size(), 4U);
+  EXPECT_EQ(a[0], 0U);
+  EXPECT_EQ(a[2], 1U);
+  EXPECT_EQ(a[3], 2U);
+
+  a.erase(a.begin(), a.begin() + 3);
+  EXPECT_EQ(a.size(), 1U);
+  EXPECT_EQ(a.front(), 2U);
+
+  IntVector b{7};
+  a.insert(a.end(), b.begin(), b.end());
+  EXPECT_EQ(a.size(), 2U);
+  EXPECT_EQ(a.back(), 7U);
+}
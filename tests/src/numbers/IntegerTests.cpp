@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cmath>
+#include <thread>
+
 #include "fintamath/numbers/Integer.hpp"
 
 using namespace fintamath;
@@ -22,6 +26,9 @@ TEST(IntegerTests, stringConstructorTest) {
 
 TEST(IntegerTests, intConstructorTest) {
   EXPECT_EQ(Integer(10), 10);
+  EXPECT_EQ(Integer(-10), Integer("-10"));
+  EXPECT_EQ(Integer(INT64_MIN), Integer("-9223372036854775808"));
+  EXPECT_EQ(Integer(INT64_MAX), Integer("9223372036854775807"));
 
   Integer a = 10;
   EXPECT_EQ(a, 10);
@@ -38,6 +45,7 @@ TEST(IntegerTests, plusAssignmentOperatorTest) {
   EXPECT_EQ(Integer(-10) += Integer(10), 0);
   EXPECT_EQ(Integer("-72838928574893245678976545678765457483992") += Integer("-387827392020390239201210"),
             Integer("-72838928574893246066803937699155696685202"));
+  EXPECT_EQ(Integer("18446744073709551615") += Integer(1), Integer("18446744073709551616"));
 }
 
 TEST(IntegerTests, intPlusAssignmentOperatorTest) {
@@ -50,8 +58,27 @@ TEST(IntegerTests, plusOperatorTest) {
             Integer("65784931996929182818848236473629"));
 }
 
+TEST(IntegerTests, carryPropagationTest) {
+  // 2^640 - 1, the carries and borrows pass through all the limbs
+  Integer a("4562440617622195218641171605700291324893228507248559930579192517899275167208677386505912811317371399"
+            "778642309573594407310688704721375437998252661319722214188251994674360264950082874192246603775");
+  Integer b("2037035976334486086268445688409378161051468393665936250636140449354381299763336706183397376");
+
+  EXPECT_EQ(a + 1, Integer("4562440617622195218641171605700291324893228507248559930579192517899275167208677386505912811317371399"
+                           "778642309573594407310688704721375437998252661319722214188251994674360264950082874192246603776"));
+  EXPECT_EQ(a + b, Integer("4562440617622195218641171605700291324893228507248559930579192517899275167208677386505912811317371399"
+                           "780679345549928893396957150409784816159304129713388150438888135123714646249846210898430001151"));
+  EXPECT_EQ(a + b - b, a);
+  EXPECT_EQ(a + 1 - a, 1);
+  EXPECT_EQ(b - (a + 1), -(a + 1 - b));
+}
+
 TEST(IntegerTests, intPlusOperatorTest) {
   EXPECT_EQ(Integer(5) + 10, 15);
+  EXPECT_EQ(Integer(-5) + 10, 5);
+  EXPECT_EQ(Integer(5) + INT64_MIN, Integer("-9223372036854775803"));
+  EXPECT_EQ(Integer("18446744073709551615") + 1, Integer("18446744073709551616"));
+  EXPECT_EQ(Integer("-18446744073709551616") + 1, Integer("-18446744073709551615"));
 }
 
 TEST(IntegerTests, friendIntPlusOperatorTest) {
@@ -63,6 +90,7 @@ TEST(IntegerTests, minusAssignmentOperatorTest) {
   EXPECT_EQ(Integer(-5) -= Integer(-10105), 10100);
   EXPECT_EQ(Integer("520039026478395743890") -= Integer("-1930275483923745483957483983"),
             Integer("1930276003962771962353227873"));
+  EXPECT_EQ(Integer("18446744073709551616") -= Integer(1), Integer("18446744073709551615"));
 }
 
 TEST(IntegerTests, intMinusAssignmentOperatorTest) {
@@ -77,6 +105,9 @@ TEST(IntegerTests, minusOperatorTest) {
 
 TEST(IntegerTests, intMinusOperatorTest) {
   EXPECT_EQ(Integer(5) - 10, -5);
+  EXPECT_EQ(Integer(-5) - 10, -15);
+  EXPECT_EQ(Integer(0) - INT64_MIN, Integer("9223372036854775808"));
+  EXPECT_EQ(Integer("18446744073709551616") - 1, Integer("18446744073709551615"));
 }
 
 TEST(IntegerTests, friendIntMinusOperatorTest) {
@@ -350,10 +381,35 @@ TEST(IntegerTests, multiplyOperatorTest) {
   EXPECT_EQ(Integer(63275) * Integer(4), 253100);
   EXPECT_EQ(Integer("-46387457368576823782") * Integer("-4837274673279875647746473847384738478378327647387463746372"),
             Integer("224388872686866615413795053083509315281416419176500823292877913926466185818904"));
+
+  // (10^n - 1)^2 = 10^(2n) - 2 * 10^n + 1
+  for (size_t n : {5000U, 12000U, 40000U, 35000U, 80000U}) {
+    Integer a(std::string(n, '9'));
+    EXPECT_EQ((a * a).toString(), std::string(n - 1, '9') + "8" + std::string(n - 1, '0') + "1");
+    EXPECT_EQ(-a * a, -(a * a));
+  }
+
+  Integer a(std::string(80000, '9'));
+  Integer b(std::string(70000, '7'));
+  EXPECT_EQ(a * b, b * a);
+  EXPECT_EQ((a + 1) * b, a * b + b);
+  EXPECT_EQ(((a + 1) * b).toString(), std::string(70000, '7') + std::string(80000, '0'));
+
+  for (auto [n, m] :
+       {std::pair<size_t, size_t>{3000, 700}, {60000, 1300}, {60000, 15000}, {1900, 1000}, {4800, 4700}}) {
+    Integer c(std::string(n, '9'));
+    Integer d(std::string(m, '9'));
+    std::string prod = std::string(m - 1, '9') + "8" + std::string(n - m, '9') + std::string(m - 1, '0') + "1";
+    EXPECT_EQ((c * d).toString(), prod);
+    EXPECT_EQ((d * c).toString(), prod);
+  }
 }
 
 TEST(IntegerTests, intMultiplyOperatorTest) {
   EXPECT_EQ(Integer(5) * 10, 50);
+  EXPECT_EQ(Integer(5) * -10, -50);
+  EXPECT_EQ(Integer(-5) * 0, 0);
+  EXPECT_EQ(Integer("18446744073709551616") * INT64_MIN, Integer("-170141183460469231731687303715884105728"));
 }
 
 TEST(IntegerTests, friendIntMultiplyOperatorTest) {
@@ -441,6 +497,11 @@ TEST(IntegerTests, divideAssignmentOperatorTest) {
                     "89266820855771268403147576567095701074005469808857005026436237359557162582162903447744543426516804"
                     "1405756975664327860057312868835959178663661834688407715795207372052181069795781487373087361"));
 
+  EXPECT_EQ(Integer("340282366920938463463374607431768211456") /= Integer("18446744073709551616"),
+            Integer("18446744073709551616"));
+  EXPECT_EQ(Integer("340282366920938463463374607431768211455") /= Integer("18446744073709551615"),
+            Integer("18446744073709551617"));
+
   EXPECT_THROW(Integer(-25) /= Integer(0), std::domain_error);
 }
 
@@ -452,10 +513,31 @@ TEST(IntegerTests, divideOperatorTest) {
   EXPECT_EQ(Integer(-25) / Integer(368273929), 0);
   EXPECT_EQ(Integer("-4837274673279875647746473847384738478378327647387463746372") / Integer("-463874573"),
             Integer("10427979792028556925767245809751978965181020274175"));
+
+  // Quotient estimate that needs the add back step of the long division
+  Integer a("1067993517960455041255406897703434155016276304550363679281903549772073508886387004178027450990591");
+  Integer b("3138550867693340382088035895064302439792088397984756137984");
+  EXPECT_EQ(a / b, Integer("340282366920938463463374607431768211455"));
+  EXPECT_EQ(a % b, Integer("3138550867693340381917894711603833208078847838342581583871"));
+  EXPECT_EQ(a / b * b + a % b, a);
+
+  for (size_t n : {3000U, 20000U}) {
+    Integer c(std::string(n, '9'));
+    Integer d(std::string(n / 3, '7'));
+    Integer e(std::string(n / 5, '3'));
+    EXPECT_EQ(c * d / d, c);
+    EXPECT_EQ((c * d + e) / d, c);
+    EXPECT_EQ((c * d + e) % d, e);
+    EXPECT_EQ((c * d - e) / d, c - 1);
+    EXPECT_EQ((c * d - e) % d, d - e);
+  }
 }
 
 TEST(IntegerTests, intDivideOperatorTest) {
   EXPECT_EQ(Integer(10) / 5, 2);
+  EXPECT_EQ(Integer(-10) / 3, -3);
+  EXPECT_EQ(Integer("170141183460469231731687303715884105728") / INT64_MIN, Integer("-18446744073709551616"));
+  EXPECT_THROW(Integer(10) / 0, std::domain_error);
 }
 
 TEST(IntegerTests, friendIntDivideOperatorTest) {
@@ -491,6 +573,9 @@ TEST(IntegerTests, moduloOperatorTest) {
 
 TEST(IntegerTests, intModuloOperatorTest) {
   EXPECT_EQ(Integer(10) % 4, 2);
+  EXPECT_EQ(Integer(-10) % 4, -2);
+  EXPECT_EQ(Integer(10) % -4, 2);
+  EXPECT_THROW(Integer(10) % 0, std::domain_error);
 }
 
 TEST(IntegerTests, friendIntModuloOperatorTest) {
@@ -584,6 +669,9 @@ TEST(IntegerTests, lessOperatorTest) {
 
 TEST(IntegerTests, intLessOperatorTest) {
   EXPECT_TRUE(Integer(283746) < 2379264);
+  EXPECT_TRUE(Integer(-283746) < -12121);
+  EXPECT_FALSE(Integer("18446744073709551616") < INT64_MAX);
+  EXPECT_TRUE(Integer("-18446744073709551616") < INT64_MIN);
 }
 
 TEST(IntegerTests, friendIntLessOperatorTest) {
@@ -656,8 +744,329 @@ TEST(IntegerTests, sqrtTest) {
   EXPECT_THROW(Integer(-9289).sqrt(), std::domain_error);
 }
 
+TEST(IntegerTests, sqrtRemTest) {
+  Integer rem;
+  EXPECT_EQ(Integer(0).sqrtRem(rem), 0);
+  EXPECT_EQ(rem, 0);
+  EXPECT_EQ(Integer(35).sqrtRem(rem), 5);
+  EXPECT_EQ(rem, 10);
+  EXPECT_EQ(Integer("68732648273642987365932706179432649827364").sqrtRem(rem), Integer("262169121510606178721"));
+  EXPECT_EQ(rem, Integer("307087949370856631523"));
+
+  Integer a(std::string(5000, '9'));
+  EXPECT_EQ((a * a).sqrtRem(rem), a);
+  EXPECT_EQ(rem, 0);
+  EXPECT_EQ((a * a - 1).sqrtRem(rem), a - 1);
+  EXPECT_EQ(rem, a * 2 - 2);
+
+  EXPECT_THROW(Integer(-9289).sqrtRem(rem), std::domain_error);
+}
+
+TEST(IntegerTests, squareTest) {
+  EXPECT_EQ(Integer(0).square(), 0);
+  EXPECT_EQ(Integer(-12).square(), 144);
+  EXPECT_EQ(Integer("18446744073709551616").square(), Integer("340282366920938463463374607431768211456"));
+
+  for (size_t n : {100U, 1000U, 6000U, 35000U}) {
+    Integer a(std::string(n, '9'));
+    EXPECT_EQ(a.square(), a * Integer(std::string(n, '9')));
+    EXPECT_EQ(a.square().toString(), std::string(n - 1, '9') + "8" + std::string(n - 1, '0') + "1");
+  }
+}
+
+TEST(IntegerTests, divModTest) {
+  Integer rem;
+
+  EXPECT_EQ(Integer(17).divMod(5, rem), 3);
+  EXPECT_EQ(rem, 2);
+  EXPECT_EQ(Integer(-17).divMod(5, rem), -3);
+  EXPECT_EQ(rem, -2);
+  EXPECT_EQ(Integer(17).divMod(-5, rem), -3);
+  EXPECT_EQ(rem, 2);
+  EXPECT_EQ(Integer(3).divMod(25, rem), 0);
+  EXPECT_EQ(rem, 3);
+  EXPECT_EQ(Integer(-25).divMod(5, rem), -5);
+  EXPECT_EQ(rem, 0);
+
+  Integer a(std::string(3000, '9') + "7");
+  Integer b(std::string(1000, '3'));
+  EXPECT_EQ(a.divMod(b, rem), a / b);
+  EXPECT_EQ(rem, a % b);
+
+  rem = a;
+  EXPECT_EQ(rem.divMod(b, rem), a / b);
+  EXPECT_EQ(rem, a % b);
+
+  EXPECT_THROW(Integer(5).divMod(0, rem), std::domain_error);
+}
+
+TEST(IntegerTests, divExactTest) {
+  EXPECT_EQ(Integer(0).divExact(7), 0);
+  EXPECT_EQ(Integer(84).divExact(-12), -7);
+  EXPECT_EQ(Integer("340282366920938463463374607431768211456").divExact(Integer("18446744073709551616")),
+            Integer("18446744073709551616"));
+  EXPECT_EQ(Integer("-224388872686866615413795053083509315281416419176500823292877913926466185818904")
+                .divExact(Integer("-46387457368576823782")),
+            Integer("4837274673279875647746473847384738478378327647387463746372"));
+
+  for (auto [n, m] : {std::pair<size_t, size_t>{300, 200}, {8000, 3000}, {40000, 20000}}) {
+    Integer a(std::string(n, '9'));
+    Integer b(std::string(m, '7') + std::string(m / 2, '0'));
+    EXPECT_EQ((a * b).divExact(b), a);
+    EXPECT_EQ((a * b).divExact(a), b);
+  }
+
+  EXPECT_THROW(Integer(5).divExact(0), std::domain_error);
+}
+
+TEST(IntegerTests, gcdTest) {
+  EXPECT_EQ(Integer(0).gcd(0), 0);
+  EXPECT_EQ(Integer(0).gcd(-15), 15);
+  EXPECT_EQ(Integer(12).gcd(18), 6);
+  EXPECT_EQ(Integer(-12).gcd(18), 6);
+  EXPECT_EQ(Integer("18446744073709551616").gcd(Integer("340282366920938463463374607431768211456")),
+            Integer("18446744073709551616"));
+  EXPECT_EQ(Integer("170141183460469231731687303715884105727").gcd(Integer("18446744073709551557")), 1);
+
+  // gcd(10^n - 1, 10^m - 1) = 10^gcd(n, m) - 1
+  Integer a(std::string(3000, '9'));
+  Integer b(std::string(1800, '9'));
+  EXPECT_EQ(a.gcd(b), Integer(std::string(600, '9')));
+  EXPECT_EQ(b.gcd(a * b), b);
+  EXPECT_EQ((a + 1).gcd(b), 1);
+
+  Integer c(std::string(60000, '9'));
+  Integer d(std::string(36000, '9'));
+  EXPECT_EQ(c.gcd(d), Integer(std::string(12000, '9')));
+  EXPECT_EQ(d.gcd(c), Integer(std::string(12000, '9')));
+
+  // gcd(F(n), F(m)) = F(gcd(n, m)), all the quotients of Fibonacci numbers are 1
+  Integer fib10000;
+  Integer fib30000;
+  Integer prev = 0;
+  Integer cur = 1;
+  for (size_t i = 1; i < 40000; i++) {
+    Integer next = cur + prev;
+    prev = cur;
+    cur = next;
+    if (i + 1 == 10000) {
+      fib10000 = cur;
+    }
+    if (i + 1 == 30000) {
+      fib30000 = cur;
+    }
+  }
+  EXPECT_EQ(cur.gcd(cur + prev), 1);
+  EXPECT_EQ(cur.gcd(fib30000), fib10000);
+}
+
+TEST(IntegerTests, gcdExtendedTest) {
+  Integer lhsFactor;
+  Integer rhsFactor;
+
+  EXPECT_EQ(Integer(240).gcdExtended(46, lhsFactor, rhsFactor), 2);
+  EXPECT_EQ(Integer(240) * lhsFactor + 46 * rhsFactor, 2);
+
+  EXPECT_EQ(Integer(-240).gcdExtended(46, lhsFactor, rhsFactor), 2);
+  EXPECT_EQ(Integer(-240) * lhsFactor + 46 * rhsFactor, 2);
+
+  EXPECT_EQ(Integer(7).gcdExtended(0, lhsFactor, rhsFactor), 7);
+  EXPECT_EQ(lhsFactor, 1);
+  EXPECT_EQ(rhsFactor, 0);
+
+  Integer a(std::string(3000, '9'));
+  Integer b = -Integer(std::string(1800, '9'));
+  EXPECT_EQ(a.gcdExtended(b, lhsFactor, rhsFactor), Integer(std::string(600, '9')));
+  EXPECT_EQ(a * lhsFactor + b * rhsFactor, Integer(std::string(600, '9')));
+}
+
+TEST(IntegerTests, basePowTest) {
+  Integer base("18446744073709551616");
+  Integer basePow2 = base * base;
+  Integer basePow5 = basePow2 * basePow2 * base;
+
+  EXPECT_EQ(basePow5 / basePow2, base * basePow2);
+  EXPECT_EQ(basePow2 / basePow5, 0);
+  EXPECT_EQ(basePow5 % basePow2, 0);
+  EXPECT_EQ((basePow5 + 1) % basePow2, 1);
+  EXPECT_EQ(basePow5.gcd(basePow2 * 6), basePow2 * 2);
+  EXPECT_EQ((7 * basePow5 + 3 * basePow2).toString(),
+            "14951909251446370576765151943186864802218931656496569389630312101856300895854873973983029913190400");
+
+  Integer val = (base * base * base + 5) * basePow2;
+  Integer remainder;
+  EXPECT_EQ(val.divMod(base + 3, remainder),
+            Integer("115792089237316195404739679802527865564825157698306010961915060771785329868865"));
+  EXPECT_EQ(remainder, Integer("18446744073709551421"));
+  EXPECT_EQ(val.divExact(basePow2), base * base * base + 5);
+
+  EXPECT_LT(basePow2, basePow2 + 1);
+  EXPECT_GT(basePow2, basePow2 - 1);
+  EXPECT_LT(-basePow5, -basePow2);
+  EXPECT_EQ(basePow5 - basePow5, 0);
+  EXPECT_EQ((basePow5 - 1) + 1, basePow5);
+
+  EXPECT_EQ(Integer(2).powMod(64, Integer("18446744073709551629")), base);
+  EXPECT_EQ(Integer(2).powMod(128, basePow2 * base + 1), basePow2);
+  EXPECT_EQ(Integer(2).powMod(128, basePow5), basePow2);
+  EXPECT_LT(Integer(2).powMod(128, basePow5), basePow2 + 1);
+}
+
+TEST(IntegerTests, shiftDecimalTest) {
+  EXPECT_EQ(Integer(0).shiftDecimalLeft(5), 0);
+  EXPECT_EQ(Integer(-12).shiftDecimalLeft(0), -12);
+  EXPECT_EQ(Integer(-12).shiftDecimalLeft(3), -12000);
+  EXPECT_EQ(Integer(7).shiftDecimalLeft(100).toString(), "7" + std::string(100, '0'));
+
+  EXPECT_EQ(Integer(12345).shiftDecimalRight(2), 123);
+  EXPECT_EQ(Integer(-12345).shiftDecimalRight(4), -1);
+  EXPECT_EQ(Integer(12345).shiftDecimalRight(5), 0);
+  EXPECT_EQ(Integer(std::string(200, '9')).shiftDecimalRight(150), Integer(std::string(50, '9')));
+  EXPECT_EQ(Integer("3" + std::string(1000, '0')).shiftDecimalRight(1000), 3);
+}
+
+TEST(IntegerTests, getSizeTest) {
+  EXPECT_EQ(Integer(0).getSize(), 1);
+  EXPECT_EQ(Integer(9).getSize(), 1);
+  EXPECT_EQ(Integer(-10).getSize(), 2);
+  EXPECT_EQ(Integer("18446744073709551615").getSize(), 20);
+  EXPECT_EQ(Integer("18446744073709551616").getSize(), 20);
+
+  for (size_t i = 1; i < 400; i += 7) {
+    Integer pow10("1" + std::string(i, '0'));
+    EXPECT_EQ(pow10.getSize(), int64_t(i) + 1);
+    EXPECT_EQ((pow10 - 1).getSize(), int64_t(i));
+    EXPECT_EQ((pow10 + 1).getSize(), int64_t(i) + 1);
+  }
+
+  Integer pow10 = 1;
+  pow10.shiftDecimalLeft(100000);
+  for (size_t i = 0; i < 100; i++) {
+    EXPECT_EQ(pow10.getSize(), 100001);
+  }
+  EXPECT_EQ((pow10 - 1).getSize(), 100000);
+  EXPECT_EQ((-pow10).getSize(), 100001);
+  EXPECT_EQ((pow10 * 2 - 1).getSize(), 100001);
+}
+
+TEST(IntegerTests, getBitsNumTest) {
+  EXPECT_EQ(Integer(0).getBitsNum(), 0U);
+  EXPECT_EQ(Integer(0).getLimbsNum(), 1U);
+  EXPECT_EQ(Integer(-255).getBitsNum(), 8U);
+  EXPECT_EQ(Integer("18446744073709551616").getBitsNum(), 65U);
+  EXPECT_EQ(Integer("18446744073709551616").getLimbsNum(), 2U);
+}
+
+TEST(IntegerTests, getLogTest) {
+  EXPECT_EQ(Integer(0).getLog2(), -HUGE_VAL);
+  EXPECT_DOUBLE_EQ(Integer(1024).getLog2(), 10);
+  EXPECT_DOUBLE_EQ(Integer(-1000).getLog10(), 3);
+  EXPECT_NEAR(Integer("1" + std::string(1000, '0')).getLog10(), 1000, 1e-9);
+  EXPECT_NEAR(Integer(std::string(100, '3')).getLog10(), 99.5228787452803, 1e-9);
+}
+
+TEST(IntegerTests, powModTest) {
+  EXPECT_EQ(Integer(4).powMod(13, 497), 445);
+  EXPECT_EQ(Integer(-4).powMod(13, 497), 52);
+  EXPECT_EQ(Integer(2).powMod(10, -1000), 24);
+  EXPECT_EQ(Integer(3).powMod(-1, 11), 4);
+  EXPECT_EQ(Integer(5).powMod(0, 7), 1);
+  EXPECT_EQ(Integer(5).powMod(3, 1), 0);
+  EXPECT_EQ(Integer(14).powMod(5, 7), 0);
+
+  Integer a(std::string(100, '7'));
+  Integer b(std::string(50, '3'));
+  EXPECT_EQ(a.powMod(b, Integer("1" + std::string(60, '0'))),
+            Integer("511573726729966473200866343367091468382247838279811943322417"));
+  EXPECT_EQ(a.powMod(b, Integer("55340232221128654848")), Integer("35940045597553152817"));
+
+  // Fermat's little theorem for the Mersenne primes 2^521 - 1 and 2^4423 - 1
+  Integer p = Integer(2).powMod(521, Integer("1" + std::string(160, '0'))) - 1;
+  EXPECT_EQ(a.powMod(p - 1, p), 1);
+  EXPECT_EQ(a.powMod(p, p), a % p);
+  Integer q = Integer(2).powMod(4423, Integer("1" + std::string(1400, '0'))) - 1;
+  EXPECT_EQ(a.powMod(q - 1, q), 1);
+  EXPECT_EQ(a.powMod(-1, q) * a % q, 1);
+
+  EXPECT_THROW(Integer(2).powMod(3, 0), std::domain_error);
+  EXPECT_THROW(Integer(2).powMod(-1, 4), std::domain_error);
+}
+
+TEST(IntegerTests, modContextTest) {
+  Integer p = Integer(2).powMod(127, Integer("1" + std::string(40, '0'))) - 1;
+  ModContext ctx(-p);
+  EXPECT_EQ(ctx.getMod(), p);
+
+  for (int64_t i = 2; i < 10; i++) {
+    EXPECT_EQ(ctx.powMod(i, p - 1), 1);
+    EXPECT_EQ(ctx.powMod(i, (p - 1) / 2) * ctx.powMod(i, (p - 1) / 2) % p, 1);
+  }
+
+  ModContext evenCtx(1000);
+  EXPECT_EQ(evenCtx.powMod(2, 10), 24);
+  EXPECT_EQ(evenCtx.powMod(-3, 3), 973);
+
+  EXPECT_THROW(ModContext(0), std::domain_error);
+}
+
+TEST(IntegerTests, threadsNumTest) {
+  EXPECT_EQ(Integer::getThreadsNum(), 1U);
+  EXPECT_THROW(Integer::setThreadsNum(0), std::invalid_argument);
+
+  Integer a(std::string(60000, '9'));
+  Integer b(std::string(25000, '7') + std::string(10000, '3'));
+  Integer c(std::string(3000, '8'));
+  Integer d(std::string(25000, '5'));
+  Integer e(std::string(200000, '6') + std::string(200000, '1'));
+  Integer ab = a * b;
+  Integer ac = a * c;
+  Integer bd = b * d;
+  Integer dd = d.square();
+  Integer ae = a * e;
+  Integer ee = e.square();
+
+  Integer::setThreadsNum(4);
+  EXPECT_EQ(Integer::getThreadsNum(), 4U);
+  EXPECT_EQ(a * b, ab);
+  EXPECT_EQ(a * c, ac);
+  EXPECT_EQ(b * d, bd);
+  EXPECT_EQ(d.square(), dd);
+  EXPECT_EQ(a * e, ae);
+  EXPECT_EQ(e.square(), ee);
+
+  Integer::setThreadsNum(1);
+  EXPECT_EQ(Integer::getThreadsNum(), 1U);
+}
+
+TEST(IntegerTests, threadsNumChangeTest) {
+  Integer a(std::string(100000, '9'));
+  Integer b(std::string(90000, '7'));
+  Integer ab = a * b;
+
+  std::atomic<bool> isFinished = false;
+  std::thread changer([&isFinished] {
+    for (size_t i = 0; !isFinished; i++) {
+      Integer::setThreadsNum(i % 3 + 1);
+    }
+  });
+
+  for (size_t i = 0; i < 20; i++) {
+    EXPECT_EQ(a * b, ab);
+  }
+
+  isFinished = true;
+  changer.join();
+
+  Integer::setThreadsNum(1);
+  EXPECT_EQ(Integer::getThreadsNum(), 1U);
+}
+
 TEST(IntegerTests, toStringTest) {
   EXPECT_EQ(Integer("618288").toString(), "618288");
   EXPECT_EQ(Integer("0").toString(), "0");
   EXPECT_EQ(Integer("-738").toString(), "-738");
+
+  std::string str = "-1" + std::string(30000, '0') + std::string(20000, '5') + std::string(10000, '0');
+  EXPECT_EQ(Integer(str).toString(), str);
+  EXPECT_EQ(Integer("000" + str.substr(1)).toString(), str.substr(1));
 }
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "fintamath/numbers/LimbsKernels.hpp"
+
+using namespace fintamath;
+
+namespace fintamath::tests {
+  struct LimbsCase {
+    std::vector<uint64_t> lhs;
+    std::vector<uint64_t> rhs;
+  };
+
+  /*
+    Random limbs and runs of all-ones and zero limbs, where the carries propagate through the whole blocks. The sizes
+    cover the vector blocks and the scalar tails after them.
+  */
+  std::vector<LimbsCase> getLimbsCases() {
+    std::mt19937_64 gen(42);
+    std::vector<LimbsCase> cases;
+
+    for (size_t size = 0; size <= 35; size++) {
+      LimbsCase randomCase{std::vector<uint64_t>(size), std::vector<uint64_t>(size)};
+      for (size_t i = 0; i < size; i++) {
+        randomCase.lhs[i] = gen();
+        randomCase.rhs[i] = gen();
+      }
+      cases.push_back(randomCase);
+
+      cases.push_back({std::vector<uint64_t>(size, UINT64_MAX), std::vector<uint64_t>(size, 0)});
+      cases.push_back({std::vector<uint64_t>(size, 0), std::vector<uint64_t>(size, UINT64_MAX)});
+      cases.push_back({std::vector<uint64_t>(size, UINT64_MAX), std::vector<uint64_t>(size, UINT64_MAX)});
+      cases.push_back({std::vector<uint64_t>(size, 0), std::vector<uint64_t>(size, 0)});
+
+      // Random runs of all-ones limbs interrupted by random ones
+      LimbsCase runsCase = randomCase;
+      for (size_t i = 0; i < size; i++) {
+        if (gen() % 4 != 0) {
+          runsCase.lhs[i] = UINT64_MAX;
+          runsCase.rhs[i] = gen() % 2 == 0 ? 0 : randomCase.rhs[i];
+        }
+      }
+      cases.push_back(runsCase);
+    }
+
+    return cases;
+  }
+
+  // Comparing the kernel with the reference one on all the cases and carries, both into res and in place
+  void checkLimbsKernel(LimbsKernel kernel, LimbsKernel reference) {
+    for (const auto &limbsCase : getLimbsCases()) {
+      size_t size = limbsCase.lhs.size();
+
+      for (uint64_t carry : {0U, 1U}) {
+        std::vector<uint64_t> expected(size);
+        uint64_t expectedCarry = reference(expected.data(), limbsCase.lhs.data(), limbsCase.rhs.data(), size, carry);
+
+        std::vector<uint64_t> res(size);
+        EXPECT_EQ(kernel(res.data(), limbsCase.lhs.data(), limbsCase.rhs.data(), size, carry), expectedCarry);
+        EXPECT_EQ(res, expected);
+
+        std::vector<uint64_t> inPlace = limbsCase.lhs;
+        EXPECT_EQ(kernel(inPlace.data(), inPlace.data(), limbsCase.rhs.data(), size, carry), expectedCarry);
+        EXPECT_EQ(inPlace, expected);
+      }
+    }
+  }
+}
+
+using namespace fintamath::tests;
+
+TEST(LimbsKernelsTests, scalarTest) {
+  std::vector<uint64_t> lhs = {UINT64_MAX, UINT64_MAX, 5};
+  std::vector<uint64_t> rhs = {1, 0, 7};
+  std::vector<uint64_t> res(3);
+
+  EXPECT_EQ(addLimbsScalar(res.data(), lhs.data(), rhs.data(), 3, 0), 0U);
+  EXPECT_EQ(res, (std::vector<uint64_t>{0, 0, 13}));
+  EXPECT_EQ(addLimbsScalar(res.data(), lhs.data(), lhs.data(), 3, 1), 0U);
+  EXPECT_EQ(res, (std::vector<uint64_t>{UINT64_MAX, UINT64_MAX, 11}));
+  EXPECT_EQ(addLimbsScalar(res.data(), lhs.data(), rhs.data(), 2, 0), 1U);
+
+  EXPECT_EQ(substractLimbsScalar(res.data(), rhs.data(), lhs.data(), 3, 0), 0U);
+  EXPECT_EQ(res, (std::vector<uint64_t>{2, 0, 1}));
+  EXPECT_EQ(substractLimbsScalar(res.data(), rhs.data(), lhs.data(), 2, 1), 1U);
+  EXPECT_EQ(res[0], 1U);
+  EXPECT_EQ(res[1], 0U);
+
+  // Substraction undoes addition with the same carry
+  for (const auto &limbsCase : getLimbsCases()) {
+    size_t size = limbsCase.lhs.size();
+
+    for (uint64_t carry : {0U, 1U}) {
+      std::vector<uint64_t> sum(size);
+      uint64_t carryOut = addLimbsScalar(sum.data(), limbsCase.lhs.data(), limbsCase.rhs.data(), size, carry);
+
+      std::vector<uint64_t> diff(size);
+      EXPECT_EQ(substractLimbsScalar(diff.data(), sum.data(), limbsCase.rhs.data(), size, carry), carryOut);
+      EXPECT_EQ(diff, limbsCase.lhs);
+    }
+  }
+}
+
+TEST(LimbsKernelsTests, avx2Test) {
+#ifdef FINTAMATH_X86_SIMD
+  if (!__builtin_cpu_supports("avx2")) {
+    GTEST_SKIP() << "AVX2 is not supported";
+  }
+  checkLimbsKernel(addLimbsAvx2, addLimbsScalar);
+  checkLimbsKernel(substractLimbsAvx2, substractLimbsScalar);
+#else
+  GTEST_SKIP() << "x86 vector kernels are not built";
+#endif
+}
+
+TEST(LimbsKernelsTests, avx512Test) {
+#ifdef FINTAMATH_X86_SIMD
+  if (!__builtin_cpu_supports("avx512f")) {
+    GTEST_SKIP() << "AVX-512 is not supported";
+  }
+  checkLimbsKernel(addLimbsAvx512, addLimbsScalar);
+  checkLimbsKernel(substractLimbsAvx512, substractLimbsScalar);
+#else
+  GTEST_SKIP() << "x86 vector kernels are not built";
+#endif
+}
+
+TEST(LimbsKernelsTests, getLimbsKernelsTest) {
+  const LimbsKernels &kernels = getLimbsKernels();
+  checkLimbsKernel(kernels.add, addLimbsScalar);
+  checkLimbsKernel(kernels.substract, substractLimbsScalar);
+}
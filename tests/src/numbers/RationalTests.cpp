@@ -255,9 +255,18 @@ TEST(RationalTests, friendIntegerNotEqualOperatorTest) {
 TEST(RationalTests, lessOperatorTest) {
   EXPECT_TRUE(Rational(5, -10) < Rational(50, 10));
 
+  EXPECT_TRUE(Rational(0) < Rational(1, 1000));
+  EXPECT_TRUE(Rational(-1, 1000) < Rational(0));
+  EXPECT_TRUE(Rational(333333, 1000000) < Rational(1, 3));
+  EXPECT_TRUE(Rational(-1, 3) < Rational(-333333, 1000000));
+  EXPECT_TRUE(Rational(Integer(std::string(40, '9')), Integer(std::string(41, '9'))) < Rational(1, 10));
+  EXPECT_TRUE(Rational(1, Integer(std::string(60, '7'))) < Rational(Integer(std::string(30, '3')), 7));
+
   EXPECT_FALSE(Rational(5, 10) < Rational(1, 2));
   EXPECT_FALSE(Rational(5, -10) < Rational(-50, 10));
   EXPECT_FALSE(Rational(55, 10) < Rational(1, 10));
+  EXPECT_FALSE(Rational(0) < Rational(0));
+  EXPECT_FALSE(Rational(7, 3) < Rational(7, 5));
 }
 
 TEST(RationalTests, integerLessOperatorTest) {
@@ -352,6 +361,78 @@ TEST(RationalTests, getDenominatorTest) {
   EXPECT_EQ(Rational(-10, 100).getDenominator(), 10);
 }
 
+TEST(RationalTests, splitIntegerFractionTest) {
+  Integer fractionNumerator;
+
+  EXPECT_EQ(Rational(5, 2).splitIntegerFraction(fractionNumerator), 2);
+  EXPECT_EQ(fractionNumerator, 1);
+  EXPECT_EQ(Rational(55).splitIntegerFraction(fractionNumerator), 55);
+  EXPECT_EQ(fractionNumerator, 0);
+  EXPECT_EQ(Rational(-10, 100).splitIntegerFraction(fractionNumerator), 0);
+  EXPECT_EQ(fractionNumerator, 1);
+  EXPECT_EQ(Rational(-23, 7).splitIntegerFraction(fractionNumerator), 3);
+  EXPECT_EQ(fractionNumerator, 2);
+}
+
+TEST(RationalTests, longArithmeticTest) {
+  // Telescoping sums and products: sum 1/(k(k+1)) = n/(n+1) and prod (k+1)/k = n+1
+  Rational sum;
+  Rational prod = 1;
+  for (int64_t i = 1; i <= 500; i++) {
+    sum += Rational(1, i * (i + 1));
+    prod *= Rational(i + 1, i);
+  }
+  EXPECT_EQ(sum, Rational(500, 501));
+  EXPECT_EQ(prod, 501);
+
+  Rational diff = 1;
+  for (int64_t i = 1; i <= 300; i++) {
+    diff -= Rational(1, i) - Rational(1, i + 1);
+    prod /= Rational(i + 1, i);
+  }
+  EXPECT_EQ(diff, Rational(1, 301));
+  EXPECT_EQ(prod, Rational(501, 301));
+
+  Rational a(Integer(std::string(50, '9')), Integer(std::string(40, '7')));
+  Rational b(Integer(std::string(40, '7')), Integer(std::string(50, '9')));
+  EXPECT_EQ(a * b, 1);
+  EXPECT_EQ(a / a, 1);
+  EXPECT_EQ(a - a, 0);
+  EXPECT_EQ((a + b) - b, a);
+  EXPECT_THROW(a / Rational(0), std::domain_error);
+}
+
+TEST(RationalTests, roundTest) {
+  EXPECT_EQ(Rational(2, 3).round(3).toString(), "667/1000");
+  EXPECT_EQ(Rational(-2, 3).round(3).toString(), "-667/1000");
+  EXPECT_EQ(Rational(1, 8).round(2).toString(), "13/100");
+  EXPECT_EQ(Rational(-1, 8).round(2).toString(), "-13/100");
+  EXPECT_EQ(Rational(1, 3).round(0), 0);
+  EXPECT_EQ(Rational(-1, 2).round(0), -1);
+  EXPECT_EQ(Rational(-1, 300).round(2), 0);
+  EXPECT_EQ(Rational(5, 4).round(10).toString(), "5/4");
+  EXPECT_EQ(Rational(1, 7).round(30), Rational("0.142857142857142857142857142857"));
+}
+
+TEST(RationalTests, scaleByPow10Test) {
+  EXPECT_EQ(Rational(3, 8).scaleByPow10(3), 375);
+  EXPECT_EQ(Rational(-3, 8).scaleByPow10(1).toString(), "-15/4");
+  EXPECT_EQ(Rational(125).scaleByPow10(-2).toString(), "5/4");
+  EXPECT_EQ(Rational(7, 3).scaleByPow10(-3).toString(), "7/3000");
+  EXPECT_EQ(Rational(0).scaleByPow10(-5), 0);
+  EXPECT_EQ(Rational(1, 3).scaleByPow10(0).toString(), "1/3");
+  EXPECT_EQ(Rational(1).scaleByPow10(-40), Rational("0." + std::string(39, '0') + "1"));
+}
+
+TEST(RationalTests, squareTest) {
+  EXPECT_EQ(Rational(0).square(), 0);
+  EXPECT_EQ(Rational(-5, 2).square(), Rational(25, 4));
+  EXPECT_EQ(Rational(-10, 100).square(), Rational(1, 100));
+
+  Rational a(2, 3);
+  EXPECT_EQ(a *= a, Rational(4, 9));
+}
+
 TEST(RationalTests, toStringTest) {
   EXPECT_EQ(Rational(5, 2).toString(), "5/2");
   EXPECT_EQ(Rational(55, -10).toString(), "-11/2");